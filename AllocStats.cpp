@@ -0,0 +1,109 @@
+#include "AllocStats.h"
+#include "GameConstants.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef ALLOCATION_TRACKING
+// Estado do frame de cada thread. Só tipos simples: thread_local com
+// construtor poderia alocar dentro do próprio operator new.
+static thread_local bool frameOpen = false;
+static thread_local bool frameSteady = false;
+static thread_local long frameAllocations = 0;
+static thread_local size_t frameBytes = 0;
+
+static std::atomic<bool> trap(false);
+static std::atomic<long> steadyFrames(0);
+static std::atomic<long> dirtyFrames(0);
+static std::atomic<long> steadyAllocations(0);
+static std::atomic<int> reported(0);
+
+static void countAllocation(size_t bytes) {
+  if (!frameOpen) {
+    return;
+  }
+  frameAllocations++;
+  frameBytes += bytes;
+  if (frameSteady && trap) {
+    fprintf(stderr, "Alocacao de %zu bytes num frame estavel\n", bytes);
+    abort();
+  }
+}
+
+void *operator new(size_t size) {
+  countAllocation(size);
+  void *p = malloc(size > 0 ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  countAllocation(size);
+  return malloc(size > 0 ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { free(p); }
+
+bool allocStatsEnabled() { return true; }
+
+void allocStatsBeginFrame(bool steady) {
+  frameAllocations = 0;
+  frameBytes = 0;
+  frameSteady = steady;
+  frameOpen = true;
+}
+
+void allocStatsAllowFrame() { frameSteady = false; }
+
+long allocStatsEndFrame(const char *name) {
+  frameOpen = false;
+  if (frameSteady) {
+    steadyFrames++;
+    if (frameAllocations > 0) {
+      dirtyFrames++;
+      steadyAllocations += frameAllocations;
+      if (reported++ < ALLOC_STATS_MAX_REPORTS) {
+        printf("Alocacao em frame estavel (%s): %ld alocacoes, %zu bytes\n",
+               name, frameAllocations, frameBytes);
+      }
+    }
+  }
+  return frameAllocations;
+}
+
+void allocStatsSetTrap(bool enabled) { trap = enabled; }
+
+long allocStatsSteadyFrames() { return steadyFrames; }
+
+long allocStatsViolations() { return dirtyFrames; }
+
+void allocStatsReport() {
+  printf("\n=== Alocacoes por frame ===\n");
+  printf("%ld frames estaveis, %ld com alocacao (%ld alocacoes)\n",
+         steadyFrames.load(), dirtyFrames.load(), steadyAllocations.load());
+}
+#else
+bool allocStatsEnabled() { return false; }
+void allocStatsBeginFrame(bool steady) { (void)steady; }
+void allocStatsAllowFrame() {}
+long allocStatsEndFrame(const char *name) {
+  (void)name;
+  return 0;
+}
+void allocStatsSetTrap(bool enabled) { (void)enabled; }
+long allocStatsSteadyFrames() { return 0; }
+long allocStatsViolations() { return 0; }
+void allocStatsReport() {}
+#endif
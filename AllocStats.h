@@ -0,0 +1,32 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <cstddef>
+
+// Verificação de "nenhuma alocação por frame". Compilado com
+// -DALLOCATION_TRACKING (make ALLOCSTATS=1), AllocStats.cpp substitui o
+// operator new e conta as alocações de cada thread entre
+// allocStatsBeginFrame() e allocStatsEndFrame(). Frames marcados como
+// estáveis (depois do aquecimento de uma tela) não deveriam alocar nada:
+// os que alocam são listados no stdout e somados no relatório. Sem a flag
+// as funções não fazem nada e devolvem zero.
+bool allocStatsEnabled();
+
+// Abre o frame da thread atual; steady diz se alocar é um erro
+void allocStatsBeginFrame(bool steady);
+// O frame atual aloca de propósito (troca de tela, ranking gravado) e
+// deixa de contar como estável
+void allocStatsAllowFrame();
+// Fecha o frame e devolve quantas alocações houve nele. name identifica o
+// frame na listagem ("desenho", "tick", ...)
+long allocStatsEndFrame(const char *name);
+
+// Com trap ligado, a primeira alocação num frame estável aborta o
+// processo, para o depurador mostrar a pilha de quem alocou
+void allocStatsSetTrap(bool enabled);
+
+long allocStatsSteadyFrames();    // Frames estáveis fechados
+long allocStatsViolations();      // Dos quais alocaram
+void allocStatsReport();          // Resumo no stdout (atexit)
+
+#endif // ALLOC_STATS_H
@@ -0,0 +1,126 @@
+#include "AssetPack.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::AssetPack() : data(nullptr), dataSize(0), mapped(false) {}
+
+AssetPack::~AssetPack() { close(); }
+
+bool AssetPack::open(const std::string &filepath) {
+  close();
+
+#ifndef _WIN32
+  int fd = ::open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(AssetPackHeader)) {
+    ::close(fd);
+    return false;
+  }
+  void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // O mapeamento continua válido sem o descritor
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  data = static_cast<const unsigned char *>(map);
+  dataSize = static_cast<size_t>(st.st_size);
+  mapped = true;
+#else
+  // Sem mmap: lê o pacote inteiro de uma vez para um único buffer
+  FILE *file = fopen(filepath.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  fseek(file, 0, SEEK_END);
+  long length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (length < (long)sizeof(AssetPackHeader)) {
+    fclose(file);
+    return false;
+  }
+  unsigned char *buffer = new unsigned char[length];
+  if (fread(buffer, 1, length, file) != (size_t)length) {
+    delete[] buffer;
+    fclose(file);
+    return false;
+  }
+  fclose(file);
+  data = buffer;
+  dataSize = static_cast<size_t>(length);
+  mapped = false;
+#endif
+
+  // Valida cabeçalho e índice antes de aceitar o pacote
+  AssetPackHeader header;
+  memcpy(&header, data, sizeof(header));
+  size_t indexEnd =
+      sizeof(header) + static_cast<size_t>(header.entryCount) *
+                           sizeof(AssetPackEntry);
+  if (memcmp(header.magic, ASSET_PACK_MAGIC, 4) != 0 ||
+      header.version != ASSET_PACK_VERSION || indexEnd > dataSize) {
+    fprintf(stderr, "Pacote de assets invalido: %s\n", filepath.c_str());
+    close();
+    return false;
+  }
+
+  entries.resize(header.entryCount);
+  if (header.entryCount > 0) {
+    memcpy(&entries[0], data + sizeof(header),
+           header.entryCount * sizeof(AssetPackEntry));
+  }
+  for (auto &entry : entries) {
+    entry.name[ASSET_PACK_NAME_LENGTH - 1] = '\0';
+    if (entry.offset > dataSize || entry.size > dataSize - entry.offset) {
+      fprintf(stderr, "Pacote de assets corrompido: %s\n", filepath.c_str());
+      close();
+      return false;
+    }
+  }
+  return true;
+}
+
+void AssetPack::close() {
+  if (data) {
+#ifndef _WIN32
+    if (mapped) {
+      munmap(const_cast<unsigned char *>(data), dataSize);
+    }
+#endif
+    if (!mapped) {
+      delete[] data;
+    }
+  }
+  data = nullptr;
+  dataSize = 0;
+  mapped = false;
+  entries.clear();
+}
+
+bool AssetPack::find(const std::string &name, const void *&blob,
+                     size_t &size) const {
+  for (const auto &entry : entries) {
+    if (name == entry.name) {
+      blob = data + entry.offset;
+      size = static_cast<size_t>(entry.size);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string assetFileName(const std::string &filepath) {
+  size_t slash = filepath.find_last_of("/\\");
+  if (slash == std::string::npos) {
+    return filepath;
+  }
+  return filepath.substr(slash + 1);
+}
@@ -0,0 +1,57 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato do pacote de assets (little-endian):
+//   AssetPackHeader
+//   AssetPackEntry[entryCount]
+//   blobs, cada um começando em um offset múltiplo de ASSET_PACK_ALIGNMENT
+const char ASSET_PACK_MAGIC[4] = {'C', 'S', 'P', 'K'};
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint32_t ASSET_PACK_ALIGNMENT = 4096; // Blobs alinhados à página
+const int ASSET_PACK_NAME_LENGTH = 48;
+
+struct AssetPackHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t alignment;
+};
+
+struct AssetPackEntry {
+  char name[ASSET_PACK_NAME_LENGTH]; // Nome do arquivo, terminado em '\0'
+  uint64_t offset;                   // Início do blob a partir do arquivo
+  uint64_t size;                     // Tamanho do blob em bytes
+};
+
+// Pacote somente leitura mapeado em memória. Os ponteiros devolvidos por
+// find() continuam válidos até close(), então podem ser lidos diretamente
+// pelo SDL_mixer sem cópias.
+class AssetPack {
+private:
+  const unsigned char *data;
+  size_t dataSize;
+  std::vector<AssetPackEntry> entries;
+  bool mapped; // false quando o conteúdo foi lido para um buffer próprio
+
+public:
+  AssetPack();
+  ~AssetPack();
+
+  bool open(const std::string &filepath);
+  void close();
+  bool isOpen() const { return data != nullptr; }
+
+  // Procura um arquivo pelo nome; devolve false se não estiver no pacote
+  bool find(const std::string &name, const void *&blob, size_t &size) const;
+  size_t getEntryCount() const { return entries.size(); }
+};
+
+// Extrai o nome do arquivo de um caminho ("assets/audio/x.ogg" -> "x.ogg")
+std::string assetFileName(const std::string &filepath);
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,150 @@
+// Ferramenta de build: empacota os arquivos listados no manifesto em um único
+// arquivo com índice e blobs alinhados (ver AssetPack.h). Termina com erro se
+// algum arquivo obrigatório estiver ausente ou inválido, o que falha o build.
+#include "AssetPack.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct ManifestItem {
+  std::string name;
+  bool optional;
+  std::vector<char> content;
+};
+
+static bool readFile(const std::string &path, std::vector<char> &content) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  content.assign(std::istreambuf_iterator<char>(in),
+                 std::istreambuf_iterator<char>());
+  return true;
+}
+
+// Confere a assinatura do formato para pegar arquivos trocados ou truncados
+static bool hasValidSignature(const std::string &name,
+                              const std::vector<char> &content) {
+  std::string ext = name.substr(name.find_last_of('.') + 1);
+  if (ext == "ogg") {
+    return content.size() >= 4 && memcmp(&content[0], "OggS", 4) == 0;
+  }
+  if (ext == "wav") {
+    return content.size() >= 12 && memcmp(&content[0], "RIFF", 4) == 0 &&
+           memcmp(&content[8], "WAVE", 4) == 0;
+  }
+  return !content.empty();
+}
+
+static uint64_t alignUp(uint64_t value) {
+  return (value + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT *
+         ASSET_PACK_ALIGNMENT;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    fprintf(stderr, "Uso: %s <manifesto> <diretorio> <saida.pak>\n", argv[0]);
+    return 1;
+  }
+  std::string manifestPath = argv[1], dir = argv[2], outputPath = argv[3];
+
+  std::ifstream manifest(manifestPath.c_str());
+  if (!manifest.is_open()) {
+    fprintf(stderr, "Erro: manifesto nao encontrado: %s\n",
+            manifestPath.c_str());
+    return 1;
+  }
+
+  std::vector<ManifestItem> items;
+  int errors = 0;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    std::stringstream ss(line);
+    std::string name, flag;
+    if (!(ss >> name) || name[0] == '#') {
+      continue;
+    }
+    ss >> flag;
+
+    ManifestItem item;
+    item.name = name;
+    item.optional = (flag == "opcional");
+    if (name.size() >= static_cast<size_t>(ASSET_PACK_NAME_LENGTH)) {
+      fprintf(stderr, "Erro: nome muito longo: %s\n", name.c_str());
+      errors++;
+      continue;
+    }
+
+    std::string path = dir + "/" + name;
+    if (!readFile(path, item.content)) {
+      if (item.optional) {
+        fprintf(stderr, "Aviso: asset opcional ausente: %s\n", path.c_str());
+      } else {
+        fprintf(stderr, "Erro: asset ausente: %s\n", path.c_str());
+        errors++;
+      }
+      continue;
+    }
+    if (!hasValidSignature(name, item.content)) {
+      fprintf(stderr, "Erro: formato invalido: %s\n", path.c_str());
+      errors++;
+      continue;
+    }
+    items.push_back(item);
+  }
+
+  if (errors > 0) {
+    fprintf(stderr, "Empacotamento falhou com %d erro(s).\n", errors);
+    return 1;
+  }
+
+  // Monta o índice com os offsets já alinhados
+  AssetPackHeader header;
+  memcpy(header.magic, ASSET_PACK_MAGIC, 4);
+  header.version = ASSET_PACK_VERSION;
+  header.entryCount = static_cast<uint32_t>(items.size());
+  header.alignment = ASSET_PACK_ALIGNMENT;
+
+  std::vector<AssetPackEntry> entries(items.size());
+  uint64_t offset =
+      alignUp(sizeof(header) + items.size() * sizeof(AssetPackEntry));
+  for (size_t i = 0; i < items.size(); ++i) {
+    memset(&entries[i], 0, sizeof(AssetPackEntry));
+    strncpy(entries[i].name, items[i].name.c_str(),
+            ASSET_PACK_NAME_LENGTH - 1);
+    entries[i].offset = offset;
+    entries[i].size = items[i].content.size();
+    offset = alignUp(offset + entries[i].size);
+  }
+
+  std::ofstream out(outputPath.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    fprintf(stderr, "Erro: nao foi possivel criar %s\n", outputPath.c_str());
+    return 1;
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!entries.empty()) {
+    out.write(reinterpret_cast<const char *>(&entries[0]),
+              entries.size() * sizeof(AssetPackEntry));
+  }
+  for (size_t i = 0; i < items.size(); ++i) {
+    // Preenche com zeros até o início alinhado do blob
+    std::vector<char> padding(entries[i].offset - out.tellp(), 0);
+    if (!padding.empty()) {
+      out.write(&padding[0], padding.size());
+    }
+    out.write(&items[i].content[0], items[i].content.size());
+  }
+  out.close();
+  if (!out) {
+    fprintf(stderr, "Erro ao escrever %s\n", outputPath.c_str());
+    return 1;
+  }
+
+  printf("Pacote %s criado com %u arquivo(s).\n", outputPath.c_str(),
+         header.entryCount);
+  return 0;
+}
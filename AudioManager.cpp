@@ -1,12 +1,42 @@
 #include "AudioManager.h"
+#include "AllocStats.h"
+#include "GameConstants.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 // Instância global
 AudioManager audioManager;
 
 AudioManager::AudioManager()
-    : musicVolume(64), soundVolume(128), isInitialized(false) {}
+    : musicVolume(64), soundVolume(128), isInitialized(false),
+      pcmCacheEnabled(false), activeMusicChannel(-1), stopStreaming(false),
+      handoverMusic(nullptr), handoverStart(0), handoverVolume(-1),
+      handoverLoops(-1),
+      nextLoadJob(0), assetsRequested(0), assetsFinished(0),
+      pendingMusicVolume(-1), pendingMusicLoops(-1), currentMusicLoops(-1),
+      lowLatencyMode(false), bufferFrames(AUDIO_DEFAULT_BUFFER_FRAMES),
+      outputFrequency(AUDIO_FREQUENCY), lastCallbackTime(0),
+      pendingTriggerTime(0), triggerDelayTotal(0), triggerDelayMax(0),
+      triggerSamples(0), callbackCount(0), underrunCount(0),
+      underrunsAtWindowStart(0), underrunWindowStart(0), fallbackCount(0),
+      soundsPlayed(0), soundsCoalesced(0), soundsStolen(0), soundsDropped(0),
+      chunkBytes(0), musicBytes(0), chunkMemory(MEMORY_AUDIO_CHUNKS),
+      musicMemory(MEMORY_MUSIC) {
+  Voice idle = {nullptr, 0};
+  voices.assign(AUDIO_MIXER_CHANNELS, idle);
+  pendingSounds.reserve(AUDIO_MIXER_CHANNELS);
+}
 
 AudioManager::~AudioManager() { cleanup(); }
 
@@ -21,20 +51,191 @@ bool AudioManager::initialize() {
   }
 
   // Inicializar SDL_mixer
-  if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+  int frames = lowLatencyMode ? AUDIO_LOW_LATENCY_BUFFER_FRAMES
+                              : AUDIO_DEFAULT_BUFFER_FRAMES;
+  if (!openDevice(frames)) {
+    return false;
+  }
+
+  isInitialized = true;
+  return true;
+}
+
+bool AudioManager::openDevice(int frames) {
+  if (Mix_OpenAudio(AUDIO_FREQUENCY, MIX_DEFAULT_FORMAT, 2, frames) < 0) {
     std::cerr << "SDL_mixer could not initialize! SDL_mixer Error: "
               << Mix_GetError() << std::endl;
     return false;
   }
+  bufferFrames = frames;
+  Uint16 format;
+  int channels;
+  Mix_QuerySpec(&outputFrequency, &format, &channels);
 
-  isInitialized = true;
+  // Os primeiros canais ficam reservados para as músicas pré-decodificadas,
+  // assim Mix_PlayChannel(-1, ...) nunca interrompe a trilha sonora
+  Mix_AllocateChannels(AUDIO_MIXER_CHANNELS);
+  Mix_ReserveChannels(MUSIC_PCM_CHANNELS);
+
+  lastCallbackTime = 0;
+  pendingTriggerTime = 0;
+  underrunsAtWindowStart = underrunCount.load();
+  underrunWindowStart = SDL_GetTicks();
+  Mix_SetPostMix(&AudioManager::postMixCallback, this);
   return true;
 }
 
+void AudioManager::postMixCallback(void *udata, Uint8 *stream, int len) {
+  (void)stream;
+  (void)len;
+  // Roda na thread de áudio, logo depois de cada buffer ser mixado
+  AudioManager *self = static_cast<AudioManager *>(udata);
+  Uint64 now = SDL_GetPerformanceCounter();
+  self->callbackCount++;
+
+  // Um intervalo maior que dois buffers significa que a saída ficou sem
+  // dados (underrun)
+  Uint64 last = self->lastCallbackTime.exchange(now);
+  Uint64 period = SDL_GetPerformanceFrequency() * self->bufferFrames /
+                  self->outputFrequency;
+  if (last != 0 && now - last > 2 * period) {
+    self->underrunCount++;
+  }
+
+  // Atraso entre o pedido do efeito e o buffer que já o contém
+  Uint64 trigger = self->pendingTriggerTime.exchange(0);
+  if (trigger != 0 && now >= trigger) {
+    Uint64 delay = now - trigger;
+    self->triggerDelayTotal += delay;
+    self->triggerSamples++;
+    Uint64 previousMax = self->triggerDelayMax.load();
+    while (delay > previousMax &&
+           !self->triggerDelayMax.compare_exchange_weak(previousMax, delay)) {
+    }
+  }
+}
+
+void AudioManager::markTrigger() {
+  // Guarda só o primeiro pedido até o próximo callback
+  Uint64 expected = 0;
+  pendingTriggerTime.compare_exchange_strong(expected,
+                                             SDL_GetPerformanceCounter());
+}
+
+void AudioManager::monitorLatency() {
+  if (!isInitialized || isLoading())
+    return;
+
+  Uint32 now = SDL_GetTicks();
+  if (now - underrunWindowStart < (Uint32)AUDIO_UNDERRUN_WINDOW_MS)
+    return;
+
+  Uint32 underruns = underrunCount.load() - underrunsAtWindowStart;
+  underrunsAtWindowStart = underrunCount.load();
+  underrunWindowStart = now;
+
+  if (underruns >= (Uint32)AUDIO_UNDERRUN_FALLBACK_THRESHOLD &&
+      bufferFrames < AUDIO_DEFAULT_BUFFER_FRAMES) {
+    int frames = std::min(bufferFrames * 2, AUDIO_DEFAULT_BUFFER_FRAMES);
+    printf("Audio: %u underruns em %d ms, aumentando buffer de %d para %d "
+           "frames\n",
+           underruns, AUDIO_UNDERRUN_WINDOW_MS, bufferFrames, frames);
+    reopenDevice(frames);
+  }
+}
+
+void AudioManager::reopenDevice(int frames) {
+  // As músicas e efeitos dependem do dispositivo aberto, então tudo é
+  // liberado e volta pelas threads de carregamento, como na abertura do
+  // jogo: processLoadedAssets instala cada arquivo quando fica pronto e a
+  // música atual volta a tocar quando a dela chegar
+  allocStatsAllowFrame();
+  std::string music = currentMusic;
+  int loops = currentMusicLoops;
+  joinLoadWorkers();
+  for (const auto &asset : loadedAssets) {
+    installAsset(asset); // Liberados logo abaixo com os demais
+  }
+  loadedAssets.clear();
+  stopStreamThread(); // As fontes são reenviadas pelo decodeAsset
+  freeLoadedAssets();
+  pcmCache.close();
+  Mix_CloseAudio();
+
+  if (!openDevice(frames)) {
+    isInitialized = false;
+    return;
+  }
+  fallbackCount++;
+  if (pcmCacheEnabled) {
+    enablePcmCache(PCM_CACHE_DIR);
+  }
+  setMusicVolume(musicVolume);
+  setSoundVolume(soundVolume);
+
+  loadJobs = assetSources;
+  nextLoadJob = 0;
+  assetsFinished = 0;
+  assetsRequested = static_cast<int>(loadJobs.size());
+  startAsyncLoading();
+  if (!music.empty()) {
+    startMusic(music, -1, loops); // Fica pendente até a música carregar
+  }
+}
+
+void AudioManager::printLatencyReport() {
+  if (!isInitialized)
+    return;
+
+  double counterMs = 1000.0 / SDL_GetPerformanceFrequency();
+  double bufferMs = 1000.0 * bufferFrames / outputFrequency;
+  Uint32 samples = triggerSamples.load();
+  double avgDelay =
+      samples ? triggerDelayTotal.load() * counterMs / samples : 0.0;
+
+  printf("=== Latencia de audio ===\n");
+  printf("Driver: %s | modo: %s | buffer: %d frames (%.1f ms)\n",
+         SDL_GetCurrentAudioDriver() ? SDL_GetCurrentAudioDriver() : "?",
+         lowLatencyMode ? "baixa latencia" : "normal", bufferFrames, bufferMs);
+  printf("Callbacks: %u | underruns: %u | fallbacks: %d\n",
+         callbackCount.load(), underrunCount.load(), fallbackCount);
+  printf("Disparo ate callback: media %.2f ms, max %.2f ms (%u amostras)\n",
+         avgDelay, triggerDelayMax.load() * counterMs, samples);
+  printf("Latencia estimada de saida: %.2f ms\n", avgDelay + bufferMs);
+  printf("Efeitos: %u tocados, %u agrupados no mesmo tick, %u vozes "
+         "roubadas, %u descartados\n",
+         soundsPlayed, soundsCoalesced, soundsStolen, soundsDropped);
+}
+
 void AudioManager::cleanup() {
   if (!isInitialized)
     return;
 
+  // Aguarda as threads de carregamento antes de liberar qualquer recurso
+  joinLoadWorkers();
+  stopStreamThread();
+  for (auto &asset : loadedAssets) {
+    if (asset.music) {
+      Mix_FreeMusic(asset.music);
+    }
+    if (asset.chunk) {
+      Mix_FreeChunk(asset.chunk);
+    }
+  }
+  loadedAssets.clear();
+  loadJobs.clear();
+  pendingMusic.clear();
+
+  freeLoadedAssets();
+  assetSources.clear();
+
+  Mix_CloseAudio();
+  pcmCache.close();  // Só depois de liberar os chunks que apontam para ele
+  assetPack.close(); // Só depois de liberar as músicas que leem do pacote
+  isInitialized = false;
+}
+
+void AudioManager::freeLoadedAssets() {
   // Parar toda música
   Mix_HaltMusic();
   Mix_HaltChannel(-1);
@@ -49,96 +250,657 @@ void AudioManager::cleanup() {
 
   // Limpar sons
   for (auto &pair : sounds) {
-    if (pair.second) {
-      Mix_FreeChunk(pair.second);
+    if (pair.second.chunk) {
+      Mix_FreeChunk(pair.second.chunk);
     }
   }
   sounds.clear();
+  pendingSounds.clear();
+  for (auto &voice : voices) {
+    voice.sound = nullptr;
+  }
 
-  Mix_CloseAudio();
-  isInitialized = false;
+  for (auto &pair : musicPcm) {
+    Mix_FreeChunk(pair.second);
+  }
+  musicPcm.clear();
+  for (auto &pair : streamPcm) {
+    Mix_FreeChunk(pair.second);
+  }
+  streamPcm.clear();
+  activeMusicChannel = -1;
+  handoverMusic = nullptr;
+
+  chunkMemory.track(chunkBytes = 0);
+  musicMemory.track(musicBytes = 0);
 }
 
-bool AudioManager::loadMusic(const std::string &name,
-                             const std::string &filepath) {
+bool AudioManager::openAssetPack(const std::string &filepath) {
   if (!isInitialized)
     return false;
+  return assetPack.open(filepath);
+}
+
+void AudioManager::enablePcmCache(const std::string &directory) {
+  if (!isInitialized)
+    return;
+
+  int frequency, channels;
+  Uint16 format;
+  if (Mix_QuerySpec(&frequency, &format, &channels) == 0)
+    return;
+  pcmCache.configure(directory, frequency, format, channels);
+  pcmCacheEnabled = true;
+}
+
+Mix_Music *AudioManager::openMusic(const std::string &filepath) {
+  const void *blob;
+  size_t size;
+  if (assetPack.find(assetFileName(filepath), blob, size)) {
+    // O stream lê direto da memória mapeada, sem cópia
+    return Mix_LoadMUS_RW(SDL_RWFromConstMem(blob, static_cast<int>(size)),
+                          1);
+  }
+  return Mix_LoadMUS(filepath.c_str());
+}
+
+Mix_Chunk *AudioManager::openSound(const std::string &filepath) {
+  const void *blob;
+  size_t size;
+  if (assetPack.find(assetFileName(filepath), blob, size)) {
+    return Mix_LoadWAV_RW(SDL_RWFromConstMem(blob, static_cast<int>(size)),
+                          1);
+  }
+  return Mix_LoadWAV(filepath.c_str());
+}
 
-  Mix_Music *newMusic = Mix_LoadMUS(filepath.c_str());
-  if (newMusic == nullptr) {
-    std::cerr << "Failed to load music: " << filepath
+AudioManager::LoadedAsset AudioManager::decodeAsset(const LoadJob &job) {
+  LoadedAsset asset = {job.name, job.isMusic, nullptr, nullptr, 0};
+
+  if (!job.isMusic) {
+    asset.chunk = openSound(job.filepath);
+    if (asset.chunk == nullptr) {
+      std::cerr << "Failed to load sound: " << job.filepath
+                << " SDL_mixer Error: " << Mix_GetError() << std::endl;
+    } else {
+      asset.bytes = sizeof(Mix_Chunk) + asset.chunk->alen;
+    }
+    return asset;
+  }
+
+  // Dados comprimidos da música: do pacote ou do arquivo solto
+  const void *source = nullptr;
+  size_t sourceSize = 0;
+  bool fromPack =
+      assetPack.find(assetFileName(job.filepath), source, sourceSize);
+  std::vector<char> fileData;
+  if (!fromPack && pcmCacheEnabled) {
+    std::ifstream in(job.filepath.c_str(), std::ios::binary);
+    fileData.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+    source = fileData.empty() ? nullptr : &fileData[0];
+    sourceSize = fileData.size();
+  }
+
+  // Músicas curtas: PCM pronto, mapeado do cache em disco
+  if (pcmCacheEnabled && source &&
+      sourceSize <= MUSIC_PCM_CACHE_MAX_SOURCE_BYTES) {
+    asset.chunk = pcmCache.load(source, sourceSize);
+    if (asset.chunk) {
+      // Mapeado do disco: conta o PCM inteiro, que fica residente ao tocar
+      asset.bytes = sizeof(Mix_Chunk) + asset.chunk->alen;
+      return asset;
+    }
+  }
+
+  // Músicas longas continuam em stream
+  asset.music = openMusic(job.filepath);
+  if (asset.music == nullptr) {
+    std::cerr << "Failed to load music: " << job.filepath
               << " SDL_mixer Error: " << Mix_GetError() << std::endl;
-    return false;
+  } else {
+    // A thread de stream mantém os dados do pacote residentes; lida do
+    // arquivo solto, a música só ocupa o buffer do SDL_mixer
+    StreamSource stream = {job.name, job.filepath, nullptr, 0};
+    if (fromPack) {
+      asset.bytes = sourceSize;
+      stream.data = static_cast<const unsigned char *>(source);
+      stream.size = sourceSize;
+    }
+    std::lock_guard<std::mutex> lock(streamMutex);
+    streamSources.push_back(stream);
+    streamWake.notify_one();
   }
+  return asset;
+}
 
-  music[name] = newMusic;
-  return true;
+void AudioManager::installAsset(const LoadedAsset &asset) {
+  if (asset.isMusic && asset.chunk) {
+    musicPcm[asset.name] = asset.chunk;
+    musicMemory.track(musicBytes += asset.bytes);
+  } else if (asset.isMusic && asset.music) {
+    music[asset.name] = asset.music;
+    musicMemory.track(musicBytes += asset.bytes);
+  } else if (!asset.isMusic && asset.chunk) {
+    chunkMemory.track(chunkBytes += asset.bytes);
+    // Efeitos sem configuração usam a prioridade e o limite padrão
+    Sound sound = {asset.chunk, SOUND_DEFAULT_PRIORITY,
+                   SOUND_DEFAULT_MAX_INSTANCES};
+    auto config = soundConfigs.find(asset.name);
+    if (config != soundConfigs.end()) {
+      sound.priority = config->second.priority;
+      sound.maxInstances = config->second.maxInstances;
+    }
+    sounds[asset.name] = sound;
+  }
 }
 
-bool AudioManager::loadSound(const std::string &name,
+bool AudioManager::loadMusic(const std::string &name,
                              const std::string &filepath) {
   if (!isInitialized)
     return false;
 
-  Mix_Chunk *newSound = Mix_LoadWAV(filepath.c_str());
-  if (newSound == nullptr) {
-    std::cerr << "Failed to load sound: " << filepath
-              << " SDL_mixer Error: " << Mix_GetError() << std::endl;
+  assetSources.push_back({name, filepath, true});
+  LoadedAsset asset = decodeAsset(assetSources.back());
+  installAsset(asset);
+  return asset.music != nullptr || asset.chunk != nullptr;
+}
+
+bool AudioManager::loadSound(const std::string &name,
+                             const std::string &filepath) {
+  if (!isInitialized)
     return false;
+
+  assetSources.push_back({name, filepath, false});
+  LoadedAsset asset = decodeAsset(assetSources.back());
+  installAsset(asset);
+  return asset.chunk != nullptr;
+}
+
+void AudioManager::queueMusic(const std::string &name,
+                              const std::string &filepath) {
+  if (!isInitialized)
+    return;
+  loadJobs.push_back({name, filepath, true});
+  assetSources.push_back(loadJobs.back());
+  assetsRequested++;
+}
+
+void AudioManager::queueSound(const std::string &name,
+                              const std::string &filepath) {
+  if (!isInitialized)
+    return;
+  loadJobs.push_back({name, filepath, false});
+  assetSources.push_back(loadJobs.back());
+  assetsRequested++;
+}
+
+void AudioManager::startAsyncLoading(int maxWorkers) {
+  if (!isInitialized || loadJobs.empty())
+    return;
+
+  // Uma thread por arquivo, limitada pelo número de núcleos disponíveis
+  int cores = static_cast<int>(std::thread::hardware_concurrency());
+  int workers = std::min(maxWorkers, static_cast<int>(loadJobs.size()));
+  if (cores > 0) {
+    workers = std::min(workers, cores);
   }
+  workers = std::max(1, workers);
 
-  sounds[name] = newSound;
-  return true;
+  for (int i = 0; i < workers; ++i) {
+    loadWorkers.push_back(std::thread(&AudioManager::loadWorker, this));
+  }
+
+  if (!streamThread.joinable()) {
+    stopStreaming = false;
+    streamThread = std::thread(&AudioManager::streamWorker, this);
+  }
 }
 
-void AudioManager::playMusic(const std::string &name, int loops) {
+void AudioManager::loadWorker() {
+  while (true) {
+    LoadJob job;
+    {
+      std::lock_guard<std::mutex> lock(loadMutex);
+      if (nextLoadJob >= loadJobs.size()) {
+        return;
+      }
+      job = loadJobs[nextLoadJob++];
+    }
+
+    // A decodificação acontece fora da thread principal
+    LoadedAsset asset = decodeAsset(job);
+
+    {
+      std::lock_guard<std::mutex> lock(loadMutex);
+      loadedAssets.push_back(asset);
+    }
+    assetsFinished++;
+  }
+}
+
+void AudioManager::joinLoadWorkers() {
+  for (auto &worker : loadWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  loadWorkers.clear();
+}
+
+// Pede ao sistema as páginas de um trecho mapeado e lê um byte de cada
+// uma. O volatile impede o compilador de descartar as leituras.
+static void keepResident(const unsigned char *data, size_t size) {
+#ifndef _WIN32
+  uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~(page - 1);
+  madvise(reinterpret_cast<void *>(start),
+          reinterpret_cast<uintptr_t>(data) + size - start, MADV_WILLNEED);
+#endif
+  volatile unsigned char sink = 0;
+  for (size_t offset = 0; offset < size; offset += ASSET_PACK_ALIGNMENT) {
+    sink = data[offset];
+  }
+  (void)sink;
+}
+
+void AudioManager::streamWorker() {
+  // Mantém na memória as páginas dos dados comprimidos das músicas em
+  // stream, para que o decodificador não espere pelo cartão SD quando a
+  // música começar. As páginas são revisitadas periodicamente porque o
+  // sistema pode descartá-las sob pressão de memória. Com o cache PCM, o
+  // começo de cada uma também é decodificado aqui, uma vez e longe da
+  // transição, para o crossfade entre duas músicas em stream; o resto da
+  // música continua em stream.
+  std::vector<std::string> decoded;
+  std::unique_lock<std::mutex> lock(streamMutex);
+  while (!stopStreaming) {
+    std::vector<StreamSource> sources = streamSources;
+    lock.unlock();
+
+    for (const auto &source : sources) {
+      if (source.data) {
+        keepResident(source.data, source.size);
+      }
+    }
+
+    for (const auto &source : sources) {
+      if (!pcmCacheEnabled || std::find(decoded.begin(), decoded.end(),
+                                        source.name) != decoded.end()) {
+        continue;
+      }
+      decoded.push_back(source.name);
+      Mix_Chunk *chunk = nullptr;
+      if (source.data) {
+        chunk =
+            pcmCache.load(source.data, source.size, MUSIC_STREAM_INTRO_MS);
+      } else {
+        std::ifstream in(source.filepath.c_str(), std::ios::binary);
+        std::vector<char> fileData((std::istreambuf_iterator<char>(in)),
+                                   std::istreambuf_iterator<char>());
+        if (!fileData.empty()) {
+          chunk = pcmCache.load(&fileData[0], fileData.size(),
+                                MUSIC_STREAM_INTRO_MS);
+        }
+      }
+
+      lock.lock();
+      if (chunk) {
+        streamPcmReady.push_back(std::make_pair(source.name, chunk));
+      }
+      bool stop = stopStreaming;
+      lock.unlock();
+      if (stop) {
+        break;
+      }
+    }
+
+    lock.lock();
+    if (sources.size() == streamSources.size()) {
+      streamWake.wait_for(lock, std::chrono::seconds(5));
+    }
+  }
+}
+
+void AudioManager::stopStreamThread() {
+  {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    stopStreaming = true;
+    streamSources.clear();
+  }
+  streamWake.notify_one();
+  if (streamThread.joinable()) {
+    streamThread.join();
+  }
+
+  // Decodificados e ainda não instalados
+  for (auto &ready : streamPcmReady) {
+    Mix_FreeChunk(ready.second);
+  }
+  streamPcmReady.clear();
+}
+
+void AudioManager::installStreamPcm() {
+  std::vector<std::pair<std::string, Mix_Chunk *>> ready;
+  {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    if (streamPcmReady.empty()) {
+      return;
+    }
+    ready.swap(streamPcmReady);
+  }
+  allocStatsAllowFrame(); // Uma vez por música longa
+  for (auto &pair : ready) {
+    Mix_Chunk *&slot = streamPcm[pair.first];
+    if (slot) {
+      Mix_FreeChunk(slot);
+    } else {
+      musicMemory.track(musicBytes += sizeof(Mix_Chunk) + pair.second->alen);
+    }
+    slot = pair.second;
+  }
+}
+
+void AudioManager::processLoadedAssets() {
   if (!isInitialized)
     return;
+  installStreamPcm();
+  updateMusicHandover(false);
+  if (loadWorkers.empty())
+    return;
+
+  // Lido antes da troca: se tudo terminou, todos os resultados já estão na
+  // fila e nenhum fica para trás ao encerrar as threads
+  bool loadingDone = !isLoading();
+
+  std::vector<LoadedAsset> ready;
+  {
+    std::lock_guard<std::mutex> lock(loadMutex);
+    ready.swap(loadedAssets);
+  }
+
+  if (!ready.empty()) {
+    allocStatsAllowFrame(); // Só durante um carregamento
+  }
+  for (const auto &asset : ready) {
+    installAsset(asset);
+  }
+
+  // Toca a música que foi pedida enquanto ainda carregava
+  if (!pendingMusic.empty() &&
+      (music.count(pendingMusic) || musicPcm.count(pendingMusic))) {
+    std::string name = pendingMusic;
+    pendingMusic.clear();
+    startMusic(name, pendingMusicVolume, pendingMusicLoops);
+  }
+
+  if (loadingDone) {
+    joinLoadWorkers();
+    loadJobs.clear();
+    pendingMusic.clear(); // Arquivo não existe, nada a esperar
+  }
+}
+
+bool AudioManager::isLoading() const {
+  return assetsFinished.load() < assetsRequested.load();
+}
+
+float AudioManager::getLoadProgress() const {
+  int requested = assetsRequested.load();
+  if (requested == 0)
+    return 1.0f;
+  return static_cast<float>(assetsFinished.load()) / requested;
+}
+
+void AudioManager::startMusic(const std::string &name, int volume,
+                              int loops) {
+  auto pcm = musicPcm.find(name);
+  auto stream = music.find(name);
+  if (pcm == musicPcm.end() && stream == music.end()) {
+    if (isLoading()) {
+      pendingMusic = name;
+      pendingMusicVolume = volume;
+      pendingMusicLoops = loops;
+    }
+    return;
+  }
+  pendingMusic.clear();
+  currentMusic = name;
+  currentMusicLoops = loops;
+  handoverMusic = nullptr; // O começo em PCM anterior sai em fade abaixo
+
+  // A música atual sai em fade enquanto a nova entra
+  if (activeMusicChannel >= 0) {
+    Mix_FadeOutChannel(activeMusicChannel, MUSIC_CROSSFADE_MS);
+  }
+  bool streamPlaying = Mix_PlayingMusic() == 1;
+
+  // Mix_Music é um só: com outra música em stream tocando, uma música
+  // longa entra pelo começo em PCM que a thread de stream já decodificou
+  // e volta ao stream quando o crossfade termina
+  Mix_Chunk *chunk = pcm != musicPcm.end() ? pcm->second : nullptr;
+  if (!chunk && streamPlaying) {
+    auto decoded = streamPcm.find(name);
+    if (decoded != streamPcm.end()) {
+      chunk = decoded->second;
+      handoverMusic = stream->second;
+      handoverStart = SDL_GetTicks();
+      handoverVolume = volume;
+      handoverLoops = loops;
+    }
+  }
+
+  if (chunk) {
+    if (streamPlaying) {
+      Mix_FadeOutMusic(MUSIC_CROSSFADE_MS);
+    }
+    // Alterna entre os canais reservados para sobrepor as duas músicas
+    int channel = (activeMusicChannel == 0) ? 1 : 0;
+    Mix_HaltChannel(channel);
+    Mix_Volume(channel, volume >= 0 ? volume : musicVolume);
+    Mix_FadeInChannel(channel, chunk, handoverMusic ? 0 : loops,
+                      MUSIC_CROSSFADE_MS);
+    activeMusicChannel = channel;
+  } else {
+    // Sem o PCM (cache desligado ou ainda decodificando), Mix_FadeInMusic
+    // esperaria o fade-out de outro stream terminar, então o stream
+    // anterior é interrompido e a nova música só entra em fade
+    if (streamPlaying) {
+      Mix_HaltMusic();
+    }
+    if (volume >= 0) {
+      Mix_VolumeMusic(volume); // Ajustar volume temporariamente
+    }
+    Mix_FadeInMusic(stream->second, loops, MUSIC_CROSSFADE_MS);
+    activeMusicChannel = -1;
+  }
+}
 
-  auto it = music.find(name);
-  if (it != music.end()) {
-    Mix_PlayMusic(it->second, loops); // -1 = loop infinito
+void AudioManager::updateMusicHandover(bool now) {
+  if (!handoverMusic) {
+    return;
+  }
+  Uint32 elapsed = SDL_GetTicks() - handoverStart;
+  if (!now && elapsed < static_cast<Uint32>(MUSIC_CROSSFADE_MS)) {
+    return;
   }
+  // O stream anterior já saiu em fade; o novo segue de onde o PCM está,
+  // com uma emenda curta entre os dois
+  Mix_HaltMusic();
+  if (handoverVolume >= 0) {
+    Mix_VolumeMusic(handoverVolume);
+  }
+  Mix_FadeInMusicPos(handoverMusic, handoverLoops, MUSIC_HANDOVER_FADE_MS,
+                     elapsed / 1000.0);
+  Mix_FadeOutChannel(activeMusicChannel, MUSIC_HANDOVER_FADE_MS);
+  activeMusicChannel = -1;
+  handoverMusic = nullptr;
+}
+
+void AudioManager::playMusic(const std::string &name, int loops) {
+  if (!isInitialized)
+    return;
+  startMusic(name, -1, loops); // -1 = loop infinito
 }
 
 void AudioManager::playMusicWithVolume(const std::string &name, int volume,
                                        int loops) {
   if (!isInitialized)
     return;
-
-  auto it = music.find(name);
-  if (it != music.end()) {
-    Mix_VolumeMusic(volume); // Ajustar volume temporariamente
-    Mix_PlayMusic(it->second, loops);
-  }
+  startMusic(name, volume, loops);
 }
 
 void AudioManager::playSound(const std::string &name) {
   if (!isInitialized)
     return;
 
+  auto it = sounds.find(name);
+  if (it == sounds.end())
+    return;
+
+  // Vários pedidos do mesmo efeito no mesmo tick viram um só
+  const Sound *sound = &it->second;
+  if (std::find(pendingSounds.begin(), pendingSounds.end(), sound) !=
+      pendingSounds.end()) {
+    soundsCoalesced++;
+    return;
+  }
+  markTrigger();
+  pendingSounds.push_back(sound);
+}
+
+int AudioManager::soundId(const std::string &name) {
+  for (size_t i = 0; i < soundIds.size(); ++i) {
+    if (soundIds[i] == name) {
+      return static_cast<int>(i);
+    }
+  }
+  soundIds.push_back(name);
+  return static_cast<int>(soundIds.size() - 1);
+}
+
+void AudioManager::playSound(int id) {
+  if (id >= 0 && id < static_cast<int>(soundIds.size())) {
+    playSound(soundIds[id]); // Chave já existente: a busca não aloca
+  }
+}
+
+void AudioManager::configureSound(const std::string &name, int priority,
+                                  int maxInstances) {
+  SoundConfig config = {priority, std::max(1, maxInstances)};
+  soundConfigs[name] = config;
   auto it = sounds.find(name);
   if (it != sounds.end()) {
-    Mix_PlayChannel(-1, it->second, 0);
+    it->second.priority = config.priority;
+    it->second.maxInstances = config.maxInstances;
   }
 }
 
+int AudioManager::allocateVoice(const Sound &sound) {
+  int instances = 0, oldestInstance = -1, freeChannel = -1, victim = -1;
+  for (int channel = MUSIC_PCM_CHANNELS; channel < AUDIO_MIXER_CHANNELS;
+       ++channel) {
+    Voice &voice = voices[channel];
+    if (voice.sound == nullptr || !Mix_Playing(channel)) {
+      voice.sound = nullptr;
+      if (freeChannel < 0) {
+        freeChannel = channel;
+      }
+      continue;
+    }
+
+    if (voice.sound == &sound) {
+      instances++;
+      if (oldestInstance < 0 ||
+          voice.startTime < voices[oldestInstance].startTime) {
+        oldestInstance = channel;
+      }
+    }
+
+    // Candidata a roubo: menor prioridade e, no empate, a mais antiga
+    if (victim < 0 || voice.sound->priority < voices[victim].sound->priority ||
+        (voice.sound->priority == voices[victim].sound->priority &&
+         voice.startTime < voices[victim].startTime)) {
+      victim = channel;
+    }
+  }
+
+  // Limite de instâncias: reinicia a cópia mais antiga do mesmo efeito
+  if (instances >= sound.maxInstances) {
+    soundsStolen++;
+    return oldestInstance;
+  }
+  if (freeChannel >= 0) {
+    return freeChannel;
+  }
+  if (victim >= 0 && voices[victim].sound->priority <= sound.priority) {
+    soundsStolen++;
+    return victim;
+  }
+  return -1; // Todas as vozes tocam efeitos mais importantes
+}
+
+void AudioManager::flushSounds() {
+  if (!isInitialized || pendingSounds.empty())
+    return;
+
+  // Os mais importantes escolhem voz primeiro. Inserção estável no próprio
+  // vetor: são poucos pedidos, e std::stable_sort aloca um buffer temporário
+  for (size_t i = 1; i < pendingSounds.size(); ++i) {
+    const Sound *sound = pendingSounds[i];
+    size_t j = i;
+    for (; j > 0 && pendingSounds[j - 1]->priority < sound->priority; --j) {
+      pendingSounds[j] = pendingSounds[j - 1];
+    }
+    pendingSounds[j] = sound;
+  }
+
+  Uint32 now = SDL_GetTicks();
+  for (const Sound *sound : pendingSounds) {
+    int channel = allocateVoice(*sound);
+    if (channel < 0) {
+      soundsDropped++;
+      continue;
+    }
+    Mix_HaltChannel(channel);
+    if (Mix_PlayChannel(channel, sound->chunk, 0) >= 0) {
+      voices[channel].sound = sound;
+      voices[channel].startTime = now;
+      soundsPlayed++;
+    }
+  }
+  pendingSounds.clear();
+}
+
 void AudioManager::pauseMusic() {
   if (!isInitialized)
     return;
+  updateMusicHandover(true); // Pausa já no stream
   Mix_PauseMusic();
+  if (activeMusicChannel >= 0) {
+    Mix_Pause(activeMusicChannel);
+  }
 }
 
 void AudioManager::resumeMusic() {
   if (!isInitialized)
     return;
   Mix_ResumeMusic();
+  if (activeMusicChannel >= 0) {
+    Mix_Resume(activeMusicChannel);
+  }
 }
 
 void AudioManager::stopMusic() {
   if (!isInitialized)
     return;
   Mix_HaltMusic();
+  for (int channel = 0; channel < MUSIC_PCM_CHANNELS; ++channel) {
+    Mix_HaltChannel(channel);
+  }
+  activeMusicChannel = -1;
+  handoverMusic = nullptr;
+  currentMusic.clear();
 }
 
 void AudioManager::setMusicVolume(int volume) {
@@ -146,18 +908,27 @@ void AudioManager::setMusicVolume(int volume) {
     return;
   musicVolume = volume;
   Mix_VolumeMusic(volume); // 0-128
+  for (int channel = 0; channel < MUSIC_PCM_CHANNELS; ++channel) {
+    Mix_Volume(channel, volume);
+  }
 }
 
 void AudioManager::setSoundVolume(int volume) {
   if (!isInitialized)
     return;
   soundVolume = volume;
-  // Aplicar a todos os canais de som
-  Mix_Volume(-1, volume);
+  // Aplicar a todos os canais de efeitos (os reservados são da música)
+  for (int channel = MUSIC_PCM_CHANNELS; channel < AUDIO_MIXER_CHANNELS;
+       ++channel) {
+    Mix_Volume(channel, volume);
+  }
 }
 
 bool AudioManager::isMusicPlaying() {
   if (!isInitialized)
     return false;
+  if (activeMusicChannel >= 0 && Mix_Playing(activeMusicChannel)) {
+    return true;
+  }
   return Mix_PlayingMusic() == 1;
 }
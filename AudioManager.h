@@ -1,32 +1,202 @@
 #ifndef AUDIOMANAGER_H
 #define AUDIOMANAGER_H
 
+#include "AssetPack.h"
+#include "MemoryStats.h"
+#include "PcmCache.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 class AudioManager {
 private:
+  // Pedido de carregamento executado por uma thread de trabalho
+  struct LoadJob {
+    std::string name;
+    std::string filepath;
+    bool isMusic;
+  };
+
+  // Resultado de um carregamento, entregue à thread principal. Músicas
+  // vindas do cache PCM chegam em chunk, com isMusic == true.
+  struct LoadedAsset {
+    std::string name;
+    bool isMusic;
+    Mix_Music *music;
+    Mix_Chunk *chunk;
+    size_t bytes; // Memória que o asset mantém enquanto instalado
+  };
+
   std::unordered_map<std::string, Mix_Music *> music;
-  std::unordered_map<std::string, Mix_Chunk *> sounds;
+  // Efeito carregado e suas regras de alocação de voz
+  struct Sound {
+    Mix_Chunk *chunk;
+    int priority;     // Maior prioridade pode roubar vozes de menor
+    int maxInstances; // Cópias simultâneas permitidas deste efeito
+  };
+
+  // Estado de cada canal de efeitos
+  struct Voice {
+    const Sound *sound; // nullptr se o canal nunca foi usado
+    Uint32 startTime;
+  };
+
+  struct SoundConfig {
+    int priority;
+    int maxInstances;
+  };
+
+  std::unordered_map<std::string, Sound> sounds;
   int musicVolume;
   int soundVolume;
   bool isInitialized;
 
+  // Pacote de assets mapeado em memória (opcional)
+  AssetPack assetPack;
+
+  // Músicas curtas pré-decodificadas, tocadas nos canais reservados
+  std::unordered_map<std::string, Mix_Chunk *> musicPcm;
+  PcmCache pcmCache;
+  bool pcmCacheEnabled;
+  int activeMusicChannel; // Canal da música PCM atual; -1 se for stream
+
+  // Música longa (stream): dados comprimidos no pacote (ou nullptr, se
+  // vier de arquivo solto) e de onde decodificá-la
+  struct StreamSource {
+    std::string name;
+    std::string filepath;
+    const unsigned char *data;
+    size_t size;
+  };
+
+  // Thread que mantém residentes os dados das músicas longas e as
+  // decodifica com antecedência para o cache PCM
+  std::thread streamThread;
+  std::mutex streamMutex;
+  std::condition_variable streamWake;
+  std::vector<StreamSource> streamSources;
+  std::vector<std::pair<std::string, Mix_Chunk *>> streamPcmReady;
+  bool stopStreaming;
+  // Começo das músicas em stream em PCM (MUSIC_STREAM_INTRO_MS), usado só
+  // quando outra música em stream está tocando: Mix_Music é um só, então o
+  // crossfade passa pelos canais e a música volta ao stream depois dele
+  std::unordered_map<std::string, Mix_Chunk *> streamPcm;
+  Mix_Music *handoverMusic; // Stream que assume no fim do crossfade
+  Uint32 handoverStart;
+  int handoverVolume;
+  int handoverLoops;
+
+  // Carregamento assíncrono
+  std::vector<LoadJob> loadJobs;
+  std::vector<LoadedAsset> loadedAssets;
+  std::vector<std::thread> loadWorkers;
+  std::mutex loadMutex;
+  size_t nextLoadJob;
+  std::atomic<int> assetsRequested;
+  std::atomic<int> assetsFinished;
+
+  // Música pedida antes de terminar de carregar
+  std::string pendingMusic;
+  int pendingMusicVolume;
+  int pendingMusicLoops;
+
+  // Tudo o que foi pedido, para recarregar se o dispositivo for reaberto
+  std::vector<LoadJob> assetSources;
+  std::string currentMusic;
+  int currentMusicLoops;
+
+  // Latência: tamanho do buffer e instrumentação do callback de áudio
+  bool lowLatencyMode;
+  int bufferFrames;
+  int outputFrequency;
+  std::atomic<Uint64> lastCallbackTime;
+  std::atomic<Uint64> pendingTriggerTime;
+  std::atomic<Uint64> triggerDelayTotal;
+  std::atomic<Uint64> triggerDelayMax;
+  std::atomic<Uint32> triggerSamples;
+  std::atomic<Uint32> callbackCount;
+  std::atomic<Uint32> underrunCount;
+  Uint32 underrunsAtWindowStart;
+  Uint32 underrunWindowStart;
+  int fallbackCount;
+
+  // Gerenciamento de vozes dos efeitos
+  std::unordered_map<std::string, SoundConfig> soundConfigs;
+  std::vector<Voice> voices;                // Indexado pelo canal
+  std::vector<const Sound *> pendingSounds; // Pedidos do tick atual
+  std::vector<std::string> soundIds;        // Nome de cada id de efeito
+  Uint32 soundsPlayed, soundsCoalesced, soundsStolen, soundsDropped;
+
+  // Memória dos assets instalados
+  size_t chunkBytes, musicBytes;
+  MemoryAccount chunkMemory, musicMemory;
+
+  Mix_Music *openMusic(const std::string &filepath);
+  Mix_Chunk *openSound(const std::string &filepath);
+  LoadedAsset decodeAsset(const LoadJob &job);
+  void installAsset(const LoadedAsset &asset);
+  void loadWorker();
+  void joinLoadWorkers();
+  void streamWorker();
+  void stopStreamThread();
+  void installStreamPcm();
+  void updateMusicHandover(bool now);
+  void startMusic(const std::string &name, int volume, int loops);
+  bool openDevice(int frames);
+  void freeLoadedAssets();
+  void reopenDevice(int frames);
+  void markTrigger();
+  int allocateVoice(const Sound &sound);
+  static void postMixCallback(void *udata, Uint8 *stream, int len);
+
 public:
   AudioManager();
   ~AudioManager();
 
+  // Buffer pequeno para efeitos com menos atraso; volta para buffers
+  // maiores sozinho se o dispositivo não acompanhar (underruns)
+  void setLowLatencyMode(bool enabled) { lowLatencyMode = enabled; }
   bool initialize();
   void cleanup();
 
+  // Verifica underruns e aplica o fallback; chamar uma vez por frame
+  void monitorLatency();
+  void printLatencyReport();
+
+  // Arquivos presentes no pacote são lidos dele em vez do disco
+  bool openAssetPack(const std::string &filepath);
+
+  // Músicas curtas passam a ser decodificadas uma vez e mapeadas do disco
+  void enablePcmCache(const std::string &directory);
+
   bool loadMusic(const std::string &name, const std::string &filepath);
   bool loadSound(const std::string &name, const std::string &filepath);
 
+  // Carregamento em segundo plano: enfileira e depois inicia as threads
+  void queueMusic(const std::string &name, const std::string &filepath);
+  void queueSound(const std::string &name, const std::string &filepath);
+  void startAsyncLoading(int maxWorkers = 4);
+  void processLoadedAssets(); // Deve ser chamada na thread principal
+  bool isLoading() const;
+  float getLoadProgress() const;
+
   void playMusic(const std::string &name, int loops = -1);
   void playMusicWithVolume(const std::string &name, int volume, int loops = -1);
+  // Efeitos pedidos no mesmo tick são agrupados e só tocam em flushSounds()
+  void configureSound(const std::string &name, int priority,
+                      int maxInstances);
   void playSound(const std::string &name);
+  // Id resolvido uma vez para efeitos tocados a cada tick: playSound(id)
+  // não monta um std::string por pedido (o efeito pode nem ter carregado)
+  int soundId(const std::string &name);
+  void playSound(int id);
+  void flushSounds();
 
   void pauseMusic();
   void resumeMusic();
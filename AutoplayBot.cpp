@@ -0,0 +1,103 @@
+#include "AutoplayBot.h"
+#include <cmath>
+
+AutoplayBot::AutoplayBot(int reactionDelayTicks, float errorRate,
+                         unsigned int seed)
+    : reactionDelayTicks(reactionDelayTicks), errorRate(errorRate),
+      rngState(seed != 0 ? seed : 1) {
+  if (this->reactionDelayTicks < 0) {
+    this->reactionDelayTicks = 0;
+  }
+  if (this->reactionDelayTicks > MAX_BOT_REACTION_TICKS) {
+    this->reactionDelayTicks = MAX_BOT_REACTION_TICKS;
+  }
+  reset();
+}
+
+void AutoplayBot::reset() {
+  historyHead = 0;
+  historyCount = 0;
+  targetIndex = -1;
+  targetSpawnTime = -1.0f;
+  chosenType = PAPER;
+}
+
+// Gerador próprio (xorshift32) para não alterar a sequência do World
+unsigned int AutoplayBot::nextRandom() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+AutoplayBot::Decision AutoplayBot::decide(const World &world) {
+  Decision d;
+  d.hasTarget = false;
+  d.targetX = world.basket.x;
+  d.wasteType = world.basket.wasteType;
+
+  // Alvo: o objeto mais baixo que ainda não passou da cesta
+  int best = -1;
+  for (size_t i = 0; i < world.objects.size(); ++i) {
+    const FallingObject &obj = world.objects[i];
+    if (obj.y < world.basket.y) {
+      continue;
+    }
+    if (best < 0 || obj.y < world.objects[best].y) {
+      best = static_cast<int>(i);
+    }
+  }
+  if (best < 0) {
+    return d;
+  }
+
+  // Objetos reaparecem no lugar: o par índice/tempo de spawn identifica o alvo
+  const FallingObject &target = world.objects[best];
+  if (best != targetIndex || target.spawnTime != targetSpawnTime) {
+    targetIndex = best;
+    targetSpawnTime = target.spawnTime;
+    chosenType = target.wasteType;
+    if ((nextRandom() >> 8) * (1.0f / 16777216.0f) < errorRate) {
+      int wrong = 1 + nextRandom() % (WASTE_TYPE_COUNT - 1);
+      chosenType = static_cast<WASTE_TYPE>((target.wasteType + wrong) %
+                                           WASTE_TYPE_COUNT);
+    }
+  }
+
+  d.hasTarget = true;
+  d.targetX = target.x;
+  d.wasteType = chosenType;
+  return d;
+}
+
+void AutoplayBot::control(World &world) {
+  history[historyHead] = decide(world);
+  historyHead = (historyHead + 1) % (MAX_BOT_REACTION_TICKS + 1);
+  if (historyCount <= reactionDelayTicks) {
+    historyCount++;
+  }
+
+  world.moveLeft = world.moveRight = false;
+  if (historyCount <= reactionDelayTicks) {
+    return; // Ainda "vendo" o início da partida
+  }
+
+  // Decisão tomada reactionDelayTicks atrás
+  int index = (historyHead - 1 - reactionDelayTicks +
+               2 * (MAX_BOT_REACTION_TICKS + 1)) %
+              (MAX_BOT_REACTION_TICKS + 1);
+  const Decision &d = history[index];
+  if (!d.hasTarget) {
+    return;
+  }
+
+  world.basket.wasteType = d.wasteType;
+
+  // Zona morta de meio passo para não oscilar em volta do alvo
+  float step = world.basket.speed * (1.0f + world.difficultyMultiplier * 0.1f);
+  float dx = d.targetX - world.basket.x;
+  if (fabs(dx) > step * 0.5f) {
+    world.moveLeft = dx < 0;
+    world.moveRight = dx > 0;
+  }
+}
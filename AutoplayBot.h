@@ -0,0 +1,46 @@
+#ifndef AUTOPLAY_BOT_H
+#define AUTOPLAY_BOT_H
+
+#include "World.h"
+
+const int MAX_BOT_REACTION_TICKS = 120; // Atraso máximo de reação (2 s)
+
+// Jogador automático: escolhe a lixeira do objeto mais próximo da cesta e
+// a move até ele. Enxerga o jogo com um atraso configurável (em ticks) e
+// erra o tipo de lixo com uma probabilidade configurável.
+class AutoplayBot {
+private:
+  struct Decision {
+    bool hasTarget;
+    float targetX;
+    WASTE_TYPE wasteType;
+  };
+
+  int reactionDelayTicks;
+  float errorRate;
+  unsigned int rngState;
+
+  // Decisões já tomadas, aplicadas reactionDelayTicks depois
+  Decision history[MAX_BOT_REACTION_TICKS + 1];
+  int historyHead;
+  int historyCount;
+
+  // Objeto seguido e o tipo escolhido para ele (sorteado uma vez por alvo)
+  int targetIndex;
+  float targetSpawnTime;
+  WASTE_TYPE chosenType;
+
+  unsigned int nextRandom();
+  Decision decide(const World &world);
+
+public:
+  AutoplayBot(int reactionDelayTicks = 10, float errorRate = 0.05f,
+              unsigned int seed = 1);
+
+  void reset(); // Nova partida
+  // Lê o estado e ajusta a direção e a lixeira da cesta; chamar uma vez
+  // por tick, antes de simulateWorld()
+  void control(World &world);
+};
+
+#endif // AUTOPLAY_BOT_H
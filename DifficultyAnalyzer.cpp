@@ -0,0 +1,337 @@
+// Analisador Monte Carlo da curva de dificuldade: para cada combinação dos
+// parâmetros varridos, joga muitas partidas com o AutoplayBot (sem janela,
+// em todos os núcleos) e grava em CSV a curva de sobrevivência e a
+// densidade de objetos em cada nível.
+//
+// Uso: ./difficultyanalyzer [--sweep PARAM=v1,v2,...]... [--games N]
+//                           [--threads N] [--delay TICKS] [--error TAXA]
+//                           [--max-seconds S] [--interval S] [--out PREFIXO]
+// PARAM: speed-rate, scaling, spawn-initial, spawn-min, max-objects
+#include "AutoplayBot.h"
+#include "Simulation.h"
+#include "World.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int MAX_ANALYZED_LEVEL = 20; // Níveis acima entram na última linha
+
+struct AnalyzerOptions {
+  int games; // Por configuração
+  int threads;
+  int reactionDelayTicks;
+  float errorRate;
+  int maxGameSeconds;
+  int intervalSeconds; // Passo da curva de sobrevivência
+  std::string outPrefix;
+  std::vector<std::vector<float> > sweeps; // Valores de cada parâmetro
+};
+
+static const char *PARAM_NAMES[] = {"speed-rate", "scaling", "spawn-initial",
+                                    "spawn-min", "max-objects"};
+const int PARAM_COUNT = 5;
+
+static float getParam(const DifficultyParams &p, int index) {
+  switch (index) {
+  case 0:
+    return p.speedIncreaseRate;
+  case 1:
+    return p.scalingFactor;
+  case 2:
+    return static_cast<float>(p.spawnDelayInitial);
+  case 3:
+    return static_cast<float>(p.spawnDelayMinimum);
+  default:
+    return static_cast<float>(p.maxNumObjects);
+  }
+}
+
+static void setParam(DifficultyParams &p, int index, float value) {
+  switch (index) {
+  case 0:
+    p.speedIncreaseRate = value;
+    break;
+  case 1:
+    p.scalingFactor = value;
+    break;
+  case 2:
+    p.spawnDelayInitial = static_cast<int>(value);
+    break;
+  case 3:
+    p.spawnDelayMinimum = static_cast<int>(value);
+    break;
+  default:
+    p.maxNumObjects = static_cast<int>(value);
+    break;
+  }
+}
+
+// "scaling=1.2,1.4,1.6" -> valores do parâmetro correspondente
+static bool parseSweep(const char *arg, AnalyzerOptions &options) {
+  const char *eq = strchr(arg, '=');
+  if (eq == 0) {
+    return false;
+  }
+  std::string name(arg, eq - arg);
+  for (int i = 0; i < PARAM_COUNT; ++i) {
+    if (name == PARAM_NAMES[i]) {
+      options.sweeps[i].clear();
+      const char *p = eq + 1;
+      while (*p != '\0') {
+        char *end;
+        options.sweeps[i].push_back(static_cast<float>(strtod(p, &end)));
+        if (end == p) {
+          return false;
+        }
+        p = (*end == ',') ? end + 1 : end;
+      }
+      return !options.sweeps[i].empty();
+    }
+  }
+  return false;
+}
+
+static bool parseOptions(int argc, char **argv, AnalyzerOptions &options) {
+  DifficultyParams defaults;
+  options.games = 2000;
+  options.threads = std::max(1u, std::thread::hardware_concurrency());
+  options.reactionDelayTicks = 10;
+  options.errorRate = 0.05f;
+  options.maxGameSeconds = 600;
+  options.intervalSeconds = 5;
+  options.outPrefix = "difficulty";
+  options.sweeps.resize(PARAM_COUNT);
+  for (int i = 0; i < PARAM_COUNT; ++i) {
+    options.sweeps[i].push_back(getParam(defaults, i));
+  }
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *value = argv[i + 1];
+    if (strcmp(argv[i], "--sweep") == 0) {
+      if (!parseSweep(value, options)) {
+        return false;
+      }
+    } else if (strcmp(argv[i], "--games") == 0) {
+      options.games = atoi(value);
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      options.threads = atoi(value);
+    } else if (strcmp(argv[i], "--delay") == 0) {
+      options.reactionDelayTicks = atoi(value);
+    } else if (strcmp(argv[i], "--error") == 0) {
+      options.errorRate = static_cast<float>(atof(value));
+    } else if (strcmp(argv[i], "--max-seconds") == 0) {
+      options.maxGameSeconds = atoi(value);
+    } else if (strcmp(argv[i], "--interval") == 0) {
+      options.intervalSeconds = atoi(value);
+    } else if (strcmp(argv[i], "--out") == 0) {
+      options.outPrefix = value;
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1 && options.games > 0 && options.threads > 0 &&
+         options.maxGameSeconds > 0 && options.intervalSeconds > 0;
+}
+
+// Produto cartesiano dos valores varridos
+static std::vector<DifficultyParams>
+buildConfigs(const AnalyzerOptions &options) {
+  std::vector<DifficultyParams> configs(1);
+  for (int i = 0; i < PARAM_COUNT; ++i) {
+    std::vector<DifficultyParams> next;
+    for (size_t c = 0; c < configs.size(); ++c) {
+      for (size_t v = 0; v < options.sweeps[i].size(); ++v) {
+        DifficultyParams p = configs[c];
+        setParam(p, i, options.sweeps[i][v]);
+        next.push_back(p);
+      }
+    }
+    configs.swap(next);
+  }
+  return configs;
+}
+
+// Acumuladores de uma configuração (um por thread, somados no fim)
+struct ConfigStats {
+  std::vector<int> lengthTicks; // Duração de cada partida
+  long long scoreSum;
+  long long levelTicks[MAX_ANALYZED_LEVEL + 1];
+  long long levelObjectTicks[MAX_ANALYZED_LEVEL + 1]; // Soma de objetos/tick
+  long long levelGames[MAX_ANALYZED_LEVEL + 1]; // Partidas que chegaram lá
+
+  ConfigStats() : scoreSum(0) {
+    for (int l = 0; l <= MAX_ANALYZED_LEVEL; ++l) {
+      levelTicks[l] = levelObjectTicks[l] = levelGames[l] = 0;
+    }
+  }
+
+  void merge(const ConfigStats &other) {
+    lengthTicks.insert(lengthTicks.end(), other.lengthTicks.begin(),
+                       other.lengthTicks.end());
+    scoreSum += other.scoreSum;
+    for (int l = 0; l <= MAX_ANALYZED_LEVEL; ++l) {
+      levelTicks[l] += other.levelTicks[l];
+      levelObjectTicks[l] += other.levelObjectTicks[l];
+      levelGames[l] += other.levelGames[l];
+    }
+  }
+};
+
+static void playGame(const AnalyzerOptions &options,
+                     const DifficultyParams &params, unsigned int seed,
+                     ConfigStats &stats) {
+  const float dt = SIMULATION_TICK_MS / 1000.0f;
+  const int maxTicks = options.maxGameSeconds * 1000 / SIMULATION_TICK_MS;
+
+  World world(seed);
+  world.difficulty = params;
+  world.reset();
+  AutoplayBot bot(options.reactionDelayTicks, options.errorRate,
+                  seed * 2654435761u);
+
+  int ticks = 0;
+  int lastLevel = 0;
+  while (!world.gameOver && ticks < maxTicks) {
+    bot.control(world);
+    simulateWorld(world, dt);
+    world.events.clear();
+    ticks++;
+
+    int level = std::min(world.difficultyLevel, MAX_ANALYZED_LEVEL);
+    if (level != lastLevel) {
+      stats.levelGames[level]++;
+      lastLevel = level;
+    }
+    stats.levelTicks[level]++;
+    stats.levelObjectTicks[level] += world.objects.size();
+  }
+  stats.lengthTicks.push_back(ticks);
+  stats.scoreSum += world.score;
+}
+
+static void writeParams(FILE *f, size_t id, const DifficultyParams &p) {
+  fprintf(f, "%zu,%g,%g,%d,%d,%d", id, p.speedIncreaseRate, p.scalingFactor,
+          p.spawnDelayInitial, p.spawnDelayMinimum, p.maxNumObjects);
+}
+
+static const char *CSV_PARAM_HEADER =
+    "config,speed_rate,scaling,spawn_initial,spawn_min,max_objects";
+
+int main(int argc, char **argv) {
+  AnalyzerOptions options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr,
+            "Uso: %s [--sweep PARAM=v1,v2,...]... [--games N] [--threads N] "
+            "[--delay TICKS] [--error TAXA] [--max-seconds S] [--interval S] "
+            "[--out PREFIXO]\n"
+            "PARAM: speed-rate, scaling, spawn-initial, spawn-min, "
+            "max-objects\n",
+            argv[0]);
+    return 1;
+  }
+
+  std::vector<DifficultyParams> configs = buildConfigs(options);
+  long long totalGames = static_cast<long long>(configs.size()) * options.games;
+  printf("%zu configuracoes x %d partidas, %d threads\n", configs.size(),
+         options.games, options.threads);
+
+  // Cada thread soma em seus próprios acumuladores: nada é compartilhado
+  // durante a simulação além do contador de trabalho
+  std::vector<std::vector<ConfigStats> > perThread(
+      options.threads, std::vector<ConfigStats>(configs.size()));
+  std::atomic<long long> nextGame(0);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      long long game;
+      while ((game = nextGame++) < totalGames) {
+        size_t config = static_cast<size_t>(game / options.games);
+        playGame(options, configs[config],
+                 static_cast<unsigned int>(game % options.games) + 1,
+                 perThread[t][config]);
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::vector<ConfigStats> stats(configs.size());
+  long long totalTicks = 0;
+  for (size_t t = 0; t < perThread.size(); ++t) {
+    for (size_t c = 0; c < configs.size(); ++c) {
+      stats[c].merge(perThread[t][c]);
+    }
+  }
+
+  std::string survivalPath = options.outPrefix + "_survival.csv";
+  std::string densityPath = options.outPrefix + "_density.csv";
+  FILE *survival = fopen(survivalPath.c_str(), "w");
+  FILE *density = fopen(densityPath.c_str(), "w");
+  if (survival == 0 || density == 0) {
+    fprintf(stderr, "Erro: nao foi possivel criar %s / %s\n",
+            survivalPath.c_str(), densityPath.c_str());
+    return 1;
+  }
+  fprintf(survival, "%s,time_s,survival\n", CSV_PARAM_HEADER);
+  fprintf(density, "%s,level,games_reached,mean_seconds_at_level,"
+                   "mean_objects_on_screen\n",
+          CSV_PARAM_HEADER);
+
+  const int ticksPerSecond = 1000 / SIMULATION_TICK_MS;
+  for (size_t c = 0; c < configs.size(); ++c) {
+    ConfigStats &s = stats[c];
+    std::sort(s.lengthTicks.begin(), s.lengthTicks.end());
+    for (size_t i = 0; i < s.lengthTicks.size(); ++i) {
+      totalTicks += s.lengthTicks[i];
+    }
+
+    // Fração das partidas ainda vivas em cada instante
+    for (int t = 0; t <= options.maxGameSeconds; t += options.intervalSeconds) {
+      long long tick = static_cast<long long>(t) * 1000 / SIMULATION_TICK_MS;
+      size_t dead = std::upper_bound(s.lengthTicks.begin(),
+                                     s.lengthTicks.end(), tick) -
+                    s.lengthTicks.begin();
+      writeParams(survival, c, configs[c]);
+      fprintf(survival, ",%d,%.4f\n", t,
+              1.0 - static_cast<double>(dead) / s.lengthTicks.size());
+    }
+
+    for (int l = 1; l <= MAX_ANALYZED_LEVEL; ++l) {
+      if (s.levelGames[l] == 0) {
+        continue;
+      }
+      writeParams(density, c, configs[c]);
+      fprintf(density, ",%d,%lld,%.2f,%.3f\n", l, s.levelGames[l],
+              static_cast<double>(s.levelTicks[l]) / s.levelGames[l] /
+                  ticksPerSecond,
+              static_cast<double>(s.levelObjectTicks[l]) / s.levelTicks[l]);
+    }
+
+    printf("config %zu: pontuacao media %.1f, duracao mediana %.1f s\n", c,
+           static_cast<double>(s.scoreSum) / s.lengthTicks.size(),
+           s.lengthTicks[s.lengthTicks.size() / 2] /
+               static_cast<double>(ticksPerSecond));
+  }
+  fclose(survival);
+  fclose(density);
+
+  double gameSeconds = static_cast<double>(totalTicks) * SIMULATION_TICK_MS /
+                       1000.0;
+  printf("Gravados %s e %s\n", survivalPath.c_str(), densityPath.c_str());
+  printf("Vazao: %.0f s de jogo/s (%lld partidas em %.2f s)\n",
+         gameSeconds / seconds, totalGames, seconds);
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include "FrameArena.h"
+#include "GameConstants.h"
+#include <cstdarg>
+#include <cstdio>
+
+const size_t ARENA_ALIGNMENT = 16;
+
+FrameArena::FrameArena(size_t capacity)
+    : block(capacity), offset(0), peakBytes(0), frameBytes(0),
+      memory(MEMORY_TEXT) {
+  memory.track(block.capacity());
+}
+
+FrameArena::~FrameArena() {
+  for (size_t i = 0; i < overflow.size(); ++i) {
+    delete[] overflow[i];
+  }
+}
+
+void FrameArena::reset() {
+  if (!overflow.empty()) {
+    for (size_t i = 0; i < overflow.size(); ++i) {
+      delete[] overflow[i];
+    }
+    overflow.clear();
+    // O frame que transbordou cabe inteiro a partir de agora
+    block.assign(peakBytes + peakBytes / 2, 0);
+    memory.track(block.capacity());
+  }
+  offset = 0;
+  frameBytes = 0;
+}
+
+void *FrameArena::allocate(size_t bytes) {
+  size_t size = (bytes + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+  frameBytes += size;
+  if (frameBytes > peakBytes) {
+    peakBytes = frameBytes;
+  }
+  if (offset + size > block.size()) {
+    char *extra = new char[size];
+    overflow.push_back(extra);
+    memory.track(block.capacity() + frameBytes - offset); // Até o reset
+    return extra;
+  }
+  void *p = &block[offset];
+  offset += size;
+  return p;
+}
+
+char *FrameArena::format(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list copy;
+  va_copy(copy, args);
+  int length = vsnprintf(NULL, 0, format, copy);
+  va_end(copy);
+  char *text = static_cast<char *>(allocate(length > 0 ? length + 1 : 1));
+  vsnprintf(text, length > 0 ? length + 1 : 1, format, args);
+  va_end(args);
+  return text;
+}
+
+FrameArena &frameArena() {
+  static thread_local FrameArena arena(FRAME_ARENA_BYTES);
+  return arena;
+}
@@ -0,0 +1,47 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "MemoryStats.h"
+#include <cstddef>
+#include <vector>
+
+// Memória de temporários que só vivem durante um frame (textos montados
+// para desenhar, listas auxiliares). Alocar é avançar um ponteiro; reset()
+// no início do frame descarta tudo de uma vez. Se um frame passar da
+// capacidade, o excedente vem do heap (e aparece no AllocStats) e o bloco
+// cresce no próximo reset(), então o frame seguinte volta a não alocar.
+class FrameArena {
+public:
+  explicit FrameArena(size_t capacity);
+  ~FrameArena();
+
+  void reset(); // Início do frame; invalida tudo o que foi alocado
+
+  void *allocate(size_t bytes); // Alinhado para qualquer tipo
+  template <typename T> T *allocateArray(size_t count) {
+    return static_cast<T *>(allocate(count * sizeof(T)));
+  }
+  // printf para uma string do frame
+  char *format(const char *format, ...);
+
+  size_t used() const { return offset; }
+  size_t peak() const { return peakBytes; } // Maior frame desde o início
+  size_t capacity() const { return block.size(); }
+
+private:
+  FrameArena(const FrameArena &);
+  FrameArena &operator=(const FrameArena &);
+
+  std::vector<char> block;
+  size_t offset;
+  size_t peakBytes;
+  size_t frameBytes; // Pedido no frame, inclusive o que transbordou
+  std::vector<char *> overflow;
+  MemoryAccount memory; // Bloco da arena, em MEMORY_TEXT
+};
+
+// Arena da thread atual, zerada por quem é dono do frame dela (display()
+// na thread do GLUT, o passo da simulação na thread de simulação)
+FrameArena &frameArena();
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,504 @@
+#include "FrameCapture.h"
+#include "AllocStats.h"
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+#include <GL/glext.h>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <zlib.h>
+
+// Funções de buffer do GL 1.5/2.1, carregadas em tempo de execução (no
+// Windows o opengl32 só exporta o GL 1.1)
+static PFNGLGENBUFFERSPROC genBuffers = NULL;
+static PFNGLBINDBUFFERPROC bindBuffer = NULL;
+static PFNGLBUFFERDATAPROC bufferData = NULL;
+static PFNGLMAPBUFFERPROC mapBuffer = NULL;
+static PFNGLUNMAPBUFFERPROC unmapBuffer = NULL;
+
+static std::string timestampedName(const char *prefix, const char *extension) {
+  char stamp[32];
+  time_t now = time(NULL);
+  strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", localtime(&now));
+  return std::string(prefix) + stamp + extension;
+}
+
+FrameCapture::FrameCapture()
+    : pixelBuffersTried(false), pixelBuffersReady(false), forceSync(false),
+      nextSlot(0), screenshotRequested(false), recording(false),
+      captureMsSum(0), capturedFrames(0),
+      jobs(CAPTURE_MAX_QUEUED + 2), jobHead(0), jobCount(0), droppedFrames(0),
+      workerRunning(false), recordingFile(NULL), recordingWidth(0),
+      recordingHeight(0), recordedFrames(0) {
+  for (int i = 0; i < CAPTURE_PBO_COUNT; ++i) {
+    slots[i].buffer = 0;
+    slots[i].capacity = 0;
+    slots[i].pending = false;
+    slots[i].width = slots[i].height = 0;
+    slots[i].screenshot = slots[i].record = false;
+  }
+}
+
+FrameCapture::~FrameCapture() {
+  shutdown();
+  for (size_t i = 0; i < freeBuffers.size(); ++i) {
+    delete freeBuffers[i];
+  }
+}
+
+void FrameCapture::requestScreenshot() { screenshotRequested = true; }
+
+void FrameCapture::startRecording(const std::string &filename) {
+  if (recording) {
+    return;
+  }
+  startWorker();
+  Job job;
+  job.type = JOB_START_RECORDING;
+  job.filename = filename.empty() ? timestampedName("gravacao_", ".y4m")
+                                  : filename;
+  job.pixels = NULL;
+  enqueue(job);
+  recording = true;
+  captureMsSum = 0;
+  capturedFrames = 0;
+  printf("Gravando em %s\n", job.filename.c_str());
+  fflush(stdout);
+}
+
+void FrameCapture::stopRecording() {
+  if (!recording) {
+    return;
+  }
+  drainSlots();
+  recording = false;
+  Job job;
+  job.type = JOB_STOP_RECORDING;
+  job.pixels = NULL;
+  job.captureMs = capturedFrames > 0 ? captureMsSum / capturedFrames : 0;
+  enqueue(job);
+}
+
+void FrameCapture::shutdown() {
+  if (recording) {
+    recording = false;
+    Job job;
+    job.type = JOB_STOP_RECORDING;
+    job.pixels = NULL;
+    job.captureMs = 0;
+    enqueue(job);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    workerRunning = false;
+  }
+  wake.notify_one();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+bool FrameCapture::initPixelBuffers() {
+  pixelBuffersTried = true;
+  const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+  const char *extensions =
+      reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
+  int major = 0, minor = 0;
+  if (version) {
+    sscanf(version, "%d.%d", &major, &minor);
+  }
+  bool supported = major > 2 || (major == 2 && minor >= 1) ||
+                   (extensions && strstr(extensions,
+                                         "GL_ARB_pixel_buffer_object"));
+
+  genBuffers = reinterpret_cast<PFNGLGENBUFFERSPROC>(
+      glutGetProcAddress("glGenBuffers"));
+  bindBuffer = reinterpret_cast<PFNGLBINDBUFFERPROC>(
+      glutGetProcAddress("glBindBuffer"));
+  bufferData = reinterpret_cast<PFNGLBUFFERDATAPROC>(
+      glutGetProcAddress("glBufferData"));
+  mapBuffer = reinterpret_cast<PFNGLMAPBUFFERPROC>(
+      glutGetProcAddress("glMapBuffer"));
+  unmapBuffer = reinterpret_cast<PFNGLUNMAPBUFFERPROC>(
+      glutGetProcAddress("glUnmapBuffer"));
+  if (!supported || !genBuffers || !bindBuffer || !bufferData ||
+      !mapBuffer || !unmapBuffer) {
+    printf("Captura: sem pixel buffer objects, leitura sincrona\n");
+    return false;
+  }
+
+  GLuint buffers[CAPTURE_PBO_COUNT];
+  genBuffers(CAPTURE_PBO_COUNT, buffers);
+  for (int i = 0; i < CAPTURE_PBO_COUNT; ++i) {
+    slots[i].buffer = buffers[i];
+  }
+  pixelBuffersReady = true;
+  return true;
+}
+
+void FrameCapture::captureFrame(int width, int height) {
+  bool wanted = screenshotRequested || recording;
+  bool pending = false;
+  for (int i = 0; i < CAPTURE_PBO_COUNT; ++i) {
+    pending = pending || slots[i].pending;
+  }
+  if (!wanted && !pending) {
+    return; // Sem captura, sem custo
+  }
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  if (wanted && !pixelBuffersTried) {
+    initPixelBuffers();
+  }
+  size_t bytes = static_cast<size_t>(width) * height * 4;
+
+  if (wanted && (!pixelBuffersReady || forceSync)) {
+    // Leitura síncrona: espera o desenho terminar
+    if (!screenshotRequested) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (queuedJobs() >= static_cast<size_t>(CAPTURE_MAX_QUEUED)) {
+        droppedFrames++;
+        return;
+      }
+    }
+    Job job;
+    job.type = JOB_FRAME;
+    job.width = width;
+    job.height = height;
+    job.screenshot = screenshotRequested;
+    job.record = recording;
+    if (job.screenshot) {
+      allocStatsAllowFrame(); // O nome do arquivo é montado agora
+      job.filename = timestampedName("captura_", ".png");
+    }
+    job.pixels = takeBuffer(bytes);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+                 &(*job.pixels)[0]);
+    startWorker();
+    enqueue(job);
+  } else {
+    if (wanted) {
+      // A cópia vai para o PBO e o frame segue sem esperar por ela
+      Slot &slot = slots[nextSlot];
+      bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+      if (slot.capacity != bytes) {
+        bufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+        slot.capacity = bytes;
+      }
+      glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+      bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+      slot.pending = true;
+      slot.width = width;
+      slot.height = height;
+      slot.screenshot = screenshotRequested;
+      slot.record = recording;
+      if (slot.screenshot) {
+        allocStatsAllowFrame();
+        slot.screenshotName = timestampedName("captura_", ".png");
+      }
+    }
+    // O próximo do anel foi lido CAPTURE_PBO_COUNT - 1 frames atrás
+    nextSlot = (nextSlot + 1) % CAPTURE_PBO_COUNT;
+    if (slots[nextSlot].pending) {
+      collect(slots[nextSlot]);
+    }
+  }
+
+  if (wanted) {
+    screenshotRequested = false;
+    captureMsSum += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    capturedFrames++;
+  }
+}
+
+void FrameCapture::collect(Slot &slot) {
+  slot.pending = false;
+  bool keep = slot.screenshot;
+  if (!keep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    keep = queuedJobs() < static_cast<size_t>(CAPTURE_MAX_QUEUED);
+    if (!keep) {
+      droppedFrames++; // A escrita não está dando conta
+    }
+  }
+  if (!keep) {
+    return;
+  }
+
+  size_t bytes = static_cast<size_t>(slot.width) * slot.height * 4;
+  bindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  const void *mapped = mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+  if (mapped) {
+    Job job;
+    job.type = JOB_FRAME;
+    job.width = slot.width;
+    job.height = slot.height;
+    job.screenshot = slot.screenshot;
+    job.record = slot.record;
+    if (job.screenshot) {
+      allocStatsAllowFrame();
+      job.filename = slot.screenshotName;
+    }
+    job.pixels = takeBuffer(bytes);
+    memcpy(&(*job.pixels)[0], mapped, bytes);
+    unmapBuffer(GL_PIXEL_PACK_BUFFER);
+    startWorker();
+    enqueue(job);
+  }
+  bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+// Recolhe todos os frames em andamento, do mais antigo ao mais novo
+void FrameCapture::drainSlots() {
+  for (int i = 0; i < CAPTURE_PBO_COUNT; ++i) {
+    Slot &slot = slots[(nextSlot + 1 + i) % CAPTURE_PBO_COUNT];
+    if (slot.pending) {
+      collect(slot);
+    }
+  }
+}
+
+void FrameCapture::enqueue(const Job &job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (jobCount == jobs.size()) {
+      // Cheia (só com início e fim de gravação além dos frames): dobra
+      std::vector<Job> bigger(jobs.size() * 2);
+      for (size_t i = 0; i < jobCount; ++i) {
+        bigger[i] = jobs[(jobHead + i) % jobs.size()];
+      }
+      jobs.swap(bigger);
+      jobHead = 0;
+    }
+    jobs[(jobHead + jobCount) % jobs.size()] = job;
+    jobCount++;
+  }
+  wake.notify_one();
+}
+
+// Buffers reaproveitados entre frames: a gravação não aloca por frame
+std::vector<unsigned char> *FrameCapture::takeBuffer(size_t bytes) {
+  std::vector<unsigned char> *buffer = NULL;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeBuffers.empty()) {
+      buffer = freeBuffers.back();
+      freeBuffers.pop_back();
+    }
+  }
+  if (!buffer) {
+    buffer = new std::vector<unsigned char>();
+  }
+  buffer->resize(bytes);
+  return buffer;
+}
+
+void FrameCapture::releaseBuffer(std::vector<unsigned char> *buffer) {
+  std::lock_guard<std::mutex> lock(mutex);
+  freeBuffers.push_back(buffer);
+}
+
+void FrameCapture::startWorker() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (workerRunning) {
+    return;
+  }
+  if (worker.joinable()) {
+    worker.join(); // Thread de um shutdown anterior, já encerrada
+  }
+  workerRunning = true;
+  worker = std::thread(&FrameCapture::workerLoop, this);
+}
+
+static void writeChunk(FILE *f, const char *type, const unsigned char *data,
+                       size_t length) {
+  unsigned char header[8] = {
+      static_cast<unsigned char>(length >> 24),
+      static_cast<unsigned char>(length >> 16),
+      static_cast<unsigned char>(length >> 8),
+      static_cast<unsigned char>(length),
+      static_cast<unsigned char>(type[0]),
+      static_cast<unsigned char>(type[1]),
+      static_cast<unsigned char>(type[2]),
+      static_cast<unsigned char>(type[3])};
+  uLong crc = crc32(0L, header + 4, 4);
+  if (length > 0) {
+    crc = crc32(crc, data, static_cast<uInt>(length));
+  }
+  unsigned char footer[4] = {static_cast<unsigned char>(crc >> 24),
+                             static_cast<unsigned char>(crc >> 16),
+                             static_cast<unsigned char>(crc >> 8),
+                             static_cast<unsigned char>(crc)};
+  fwrite(header, 1, 8, f);
+  fwrite(data, 1, length, f);
+  fwrite(footer, 1, 4, f);
+}
+
+// PNG RGB de 8 bits. Cada linha usa o filtro Sub (diferença para o pixel à
+// esquerda): o céu e os prédios lisos viram zeros, que o deflate comprime
+static bool writePng(const std::string &filename, int width, int height,
+                     const unsigned char *rgba) {
+  size_t rowBytes = static_cast<size_t>(width) * 3 + 1;
+  std::vector<unsigned char> raw(rowBytes * height);
+  for (int y = 0; y < height; ++y) {
+    const unsigned char *src = rgba + static_cast<size_t>(height - 1 - y) *
+                                          width * 4; // GL: de baixo para cima
+    unsigned char *dst = &raw[y * rowBytes];
+    dst[0] = 1;
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        unsigned char left = x > 0 ? src[(x - 1) * 4 + c] : 0;
+        dst[1 + x * 3 + c] = static_cast<unsigned char>(src[x * 4 + c] - left);
+      }
+    }
+  }
+  uLongf compressedSize = compressBound(raw.size());
+  std::vector<unsigned char> compressed(compressedSize);
+  if (compress2(&compressed[0], &compressedSize, &raw[0], raw.size(),
+                Z_DEFAULT_COMPRESSION) != Z_OK) {
+    return false;
+  }
+
+  FILE *f = fopen(filename.c_str(), "wb");
+  if (!f) {
+    return false;
+  }
+  const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a,
+                                      '\n'};
+  fwrite(signature, 1, 8, f);
+  unsigned char ihdr[13] = {static_cast<unsigned char>(width >> 24),
+                            static_cast<unsigned char>(width >> 16),
+                            static_cast<unsigned char>(width >> 8),
+                            static_cast<unsigned char>(width),
+                            static_cast<unsigned char>(height >> 24),
+                            static_cast<unsigned char>(height >> 16),
+                            static_cast<unsigned char>(height >> 8),
+                            static_cast<unsigned char>(height),
+                            8, 2, 0, 0, 0}; // 8 bits, RGB, sem entrelaçar
+  writeChunk(f, "IHDR", ihdr, sizeof(ihdr));
+  writeChunk(f, "IDAT", &compressed[0], compressedSize);
+  writeChunk(f, "IEND", NULL, 0);
+  bool ok = !ferror(f);
+  fclose(f);
+  return ok;
+}
+
+// Y4M 4:2:0 com a matriz BT.601 de faixa completa (C420jpeg); a largura e
+// a altura são arredondadas para baixo até um número par
+void FrameCapture::writeRecordingFrame(const Job &job) {
+  if (!recordingFile) {
+    return;
+  }
+  int w = job.width & ~1, h = job.height & ~1;
+  if (recordingWidth == 0) {
+    recordingWidth = w;
+    recordingHeight = h;
+    fprintf(recordingFile, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", w,
+            h, CAPTURE_RECORD_FPS);
+  }
+  if (w != recordingWidth || h != recordingHeight) {
+    std::lock_guard<std::mutex> lock(mutex);
+    droppedFrames++; // Janela redimensionada: o Y4M tem tamanho fixo
+    return;
+  }
+
+  const unsigned char *rgba = &(*job.pixels)[0];
+  size_t lumaSize = static_cast<size_t>(w) * h;
+  yuv.resize(lumaSize + lumaSize / 2);
+  unsigned char *yPlane = &yuv[0];
+  unsigned char *uPlane = yPlane + lumaSize;
+  unsigned char *vPlane = uPlane + lumaSize / 4;
+  for (int y = 0; y < h; y += 2) {
+    // Duas linhas da imagem, na ordem de cima para baixo
+    const unsigned char *row0 =
+        rgba + static_cast<size_t>(job.height - 1 - y) * job.width * 4;
+    const unsigned char *row1 = row0 - static_cast<size_t>(job.width) * 4;
+    for (int x = 0; x < w; x += 2) {
+      int r = 0, g = 0, b = 0;
+      for (int dy = 0; dy < 2; ++dy) {
+        const unsigned char *row = dy == 0 ? row0 : row1;
+        for (int dx = 0; dx < 2; ++dx) {
+          const unsigned char *p = row + (x + dx) * 4;
+          yPlane[(y + dy) * w + x + dx] = static_cast<unsigned char>(
+              (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+          r += p[0];
+          g += p[1];
+          b += p[2];
+        }
+      }
+      r /= 4;
+      g /= 4;
+      b /= 4;
+      size_t c = static_cast<size_t>(y / 2) * (w / 2) + x / 2;
+      uPlane[c] =
+          static_cast<unsigned char>((-43 * r - 85 * g + 128 * b + 32896) >> 8);
+      vPlane[c] =
+          static_cast<unsigned char>((128 * r - 107 * g - 21 * b + 32896) >> 8);
+    }
+  }
+  fputs("FRAME\n", recordingFile);
+  fwrite(&yuv[0], 1, yuv.size(), recordingFile);
+  recordedFrames++;
+}
+
+void FrameCapture::workerLoop() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this] { return jobCount > 0 || !workerRunning; });
+      if (jobCount == 0) {
+        return; // Encerrando e sem nada pendente
+      }
+      job = jobs[jobHead];
+      jobHead = (jobHead + 1) % jobs.size();
+      jobCount--;
+    }
+
+    switch (job.type) {
+    case JOB_START_RECORDING:
+      recordingFile = fopen(job.filename.c_str(), "wb");
+      if (!recordingFile) {
+        fprintf(stderr, "Erro ao criar %s\n", job.filename.c_str());
+      }
+      recordingName = job.filename;
+      recordingWidth = recordingHeight = 0;
+      recordedFrames = 0;
+      break;
+    case JOB_STOP_RECORDING:
+      if (recordingFile) {
+        fclose(recordingFile);
+        recordingFile = NULL;
+        long dropped;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          dropped = droppedFrames;
+          droppedFrames = 0;
+        }
+        printf("Gravacao encerrada: %s, %ld frames, %ld descartados, "
+               "%.3f ms por frame na thread do desenho\n",
+               recordingName.c_str(), recordedFrames, dropped,
+               job.captureMs);
+        fflush(stdout);
+      }
+      break;
+    case JOB_FRAME:
+      if (job.screenshot) {
+        if (writePng(job.filename, job.width, job.height, &(*job.pixels)[0])) {
+          printf("Captura de tela: %s\n", job.filename.c_str());
+        } else {
+          fprintf(stderr, "Erro ao gravar %s\n", job.filename.c_str());
+        }
+        fflush(stdout);
+      }
+      if (job.record) {
+        writeRecordingFrame(job);
+      }
+      releaseBuffer(job.pixels);
+      break;
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include "GameConstants.h"
+#include <GL/gl.h>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Captura do framebuffer para capturas de tela (PNG) e gravações (Y4M)
+// sem travar o frame. glReadPixels escreve num anel de CAPTURE_PBO_COUNT
+// pixel buffer objects e cada um só é mapeado CAPTURE_PBO_COUNT - 1 frames
+// depois, quando a cópia já terminou. Conversão, compressão e escrita
+// ficam numa thread própria; se ela não der conta, frames da gravação são
+// descartados (e contados) em vez de atrasar o jogo. Sem PBOs (GL < 2.1)
+// a leitura é síncrona, mas a escrita continua fora da thread do GL.
+class FrameCapture {
+public:
+  FrameCapture();
+  ~FrameCapture();
+
+  void requestScreenshot(); // O próximo frame vira captura_<data>.png
+  // Vazio: gravacao_<data>.y4m
+  void startRecording(const std::string &filename = "");
+  void stopRecording(); // Thread do GL: esvazia o anel antes de fechar
+  bool isRecording() const { return recording; }
+  void setSynchronous(bool sync) { forceSync = sync; } // Comparação
+
+  // Depois de desenhar, antes da troca de buffers (thread do GL)
+  void captureFrame(int width, int height);
+
+  // Termina a gravação e espera a escrita do que já foi lido
+  void shutdown();
+
+private:
+  enum JobType { JOB_FRAME, JOB_START_RECORDING, JOB_STOP_RECORDING };
+
+  struct Job {
+    JobType type;
+    int width, height;
+    bool screenshot, record;
+    std::string filename;       // Captura ou arquivo da gravação
+    std::vector<unsigned char> *pixels; // RGBA, linhas de baixo para cima
+    double captureMs; // Fim da gravação: custo médio na thread do GL
+  };
+
+  struct Slot {
+    GLuint buffer;
+    size_t capacity; // Bytes alocados no PBO
+    bool pending;    // Leitura em andamento
+    int width, height;
+    bool screenshot, record;
+    std::string screenshotName;
+  };
+
+  bool initPixelBuffers();
+  void collect(Slot &slot);
+  void drainSlots();
+  void enqueue(const Job &job);
+  size_t queuedJobs() const { return jobCount; } // Com o mutex
+  std::vector<unsigned char> *takeBuffer(size_t bytes);
+  void releaseBuffer(std::vector<unsigned char> *buffer);
+  void startWorker();
+  void workerLoop();
+  void writeRecordingFrame(const Job &job);
+
+  // Thread do GL
+  bool pixelBuffersTried, pixelBuffersReady, forceSync;
+  Slot slots[CAPTURE_PBO_COUNT];
+  int nextSlot;
+  bool screenshotRequested;
+  bool recording;
+  double captureMsSum; // Custo da captura na thread do GL
+  long capturedFrames;
+
+  // Compartilhado com a thread de escrita
+  std::mutex mutex;
+  std::condition_variable wake;
+  // Fila circular de trabalhos: não aloca por frame, só cresce se encher
+  std::vector<Job> jobs;
+  size_t jobHead, jobCount;
+  std::vector<std::vector<unsigned char> *> freeBuffers;
+  long droppedFrames;
+  bool workerRunning;
+  std::thread worker;
+
+  // Thread de escrita
+  FILE *recordingFile;
+  std::string recordingName;
+  int recordingWidth, recordingHeight;
+  long recordedFrames;
+  std::vector<unsigned char> yuv;
+};
+
+#endif // FRAME_CAPTURE_H
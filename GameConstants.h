@@ -2,6 +2,7 @@
 #define GAME_CONSTANTS_H
 
 #include <GL/glut.h>
+#include <cstddef>
 #include <string>
 
 // Constantes Globais de Jogo
@@ -11,6 +12,17 @@ const std::string RANKING_FILENAME =
 const int MAX_RANKING_DISPLAY_ENTRIES =
     5;                                 // Quantidade de scores a serem exibidos
 const int MAX_PLAYER_NAME_LENGTH = 15; // Comprimento máximo do nome do jogador
+const std::string SAVEGAME_FILENAME =
+    "savegame.bin"; // Partida em andamento (retomada com --resume)
+const int AUTOSAVE_INTERVAL_TICKS = 300; // Salva a partida a cada ~5 s
+const size_t AUTOSAVE_BLOB_RESERVE =
+    16 * 1024; // Bytes reservados para a imagem da partida salva
+const int REWIND_MAX_FRAMES = 600; // Ticks guardados para voltar (~10 s)
+const size_t REWIND_MEMORY_BUDGET =
+    8 * 1024 * 1024; // Memória máxima do histórico de rewind
+const int REWIND_KEYFRAME_INTERVAL = 60; // Um quadro inteiro por segundo
+const size_t REWIND_FRAME_RESERVE =
+    1024; // Bytes reservados por quadro (um delta típico cabe folgado)
 
 // Variáveis Globais para dificuldade dinâmica
 const int MAX_NUM_OBJECTS =
@@ -28,12 +40,55 @@ const float DIFFICULTY_SCALING_FACTOR =
     1.4f;                            // Fator de escalonamento da dificuldade
 const int SPAWN_DELAY_INITIAL = 120; // Delay inicial entre spawns (frames)
 const int SPAWN_DELAY_MINIMUM = 30;  // Delay mínimo entre spawns
+const int SPAWN_LANE_COUNT = 6; // Faixas de spawn em x (largura 1.8 / 0.3)
+const float MIN_SPAWN_DISTANCE = 0.3f; // Distância mínima entre objetos
+const float OBJECT_SIZE = 0.12f;       // Tamanho dos objetos que caem
+
+// Modo stress (--stress N): milhares de objetos menores e várias cestas
+const float STRESS_OBJECT_SIZE = 0.04f;
+const float STRESS_SPAWN_DISTANCE = 0.06f; // 30 faixas de spawn
+const int STRESS_FILL_TICKS = 120; // Tempo para encher a tela (~2 s)
+
+// Nível de detalhe das formas de lixo pelo tamanho na tela (pixels)
+const float WASTE_LOD_FULL_PIXELS = 24.0f;
+const float WASTE_LOD_REDUCED_PIXELS = 10.0f;
 
 // Animação
 const float GAMEOVER_ANIMATION_DURATION =
     1.5f; // Duração total da animação em segundos
 const float HOMESCREEN_ANIMATION_DURATION =
     2.0f; // Duração da animação de entrada
+const int TRASH_RAIN_EMISSION_ODDS = 2; // Uma partícula a cada 2 ticks
+const int TRASH_RAIN_MAX_PARTICLES = 1200;
+const int TRASH_RAIN_MAX_FALLING = 256; // Caindo ao mesmo tempo
+// Partículas paradas compactadas (SettledParticle): posição em ponto fixo
+// de 16 bits (até +-4 unidades), tamanho em 8 bits (até ~0,25)
+const float SETTLED_POSITION_SCALE = 8192.0f;
+const float SETTLED_SIZE_SCALE = 1024.0f;
+const int SETTLED_SIZE_TO_POSITION = 8; // Passo do tamanho em passos de posição
+
+// Threads de simulação e desenho
+const int SIMULATION_TICK_MS = 16; // Passo fixo da simulação (~60 Hz)
+const int RENDER_INTERVAL_MS = 16; // Intervalo entre pedidos de redesenho
+const int MAX_CATCHUP_TICKS = 8; // Ticks recuperados num passo após engasgo
+
+// Governador de qualidade (QualityGovernor)
+const int QUALITY_LEVEL_COUNT = 4;
+const int QUALITY_TARGET_FPS = 60;
+const int QUALITY_WINDOW_FRAMES = 60; // Frames por decisão (~1 s)
+const double QUALITY_LATE_FRAME_FACTOR =
+    1.5; // Frame atrasado: intervalo acima de 1,5x o orçamento
+
+// Captura de tela e gravação (FrameCapture)
+const int CAPTURE_PBO_COUNT = 3;   // Frame lido CAPTURE_PBO_COUNT - 1 depois
+const int CAPTURE_MAX_QUEUED = 8;  // Frames esperando a escrita; além, descarta
+const int CAPTURE_RECORD_FPS = 60; // Taxa declarada no cabeçalho do Y4M
+
+// Memória dos frames (FrameArena, AllocStats)
+const size_t FRAME_ARENA_BYTES = 16 * 1024; // Temporários de um frame
+const int ALLOC_WARMUP_FRAMES =
+    120; // Frames após trocar de tela em que alocar ainda é esperado
+const int ALLOC_STATS_MAX_REPORTS = 20; // Frames com alocação listados
 
 // Estados do Jogo
 enum GameState { STATE_HOME, STATE_PLAYING, STATE_PAUSED, STATE_GAMEOVER };
@@ -55,10 +110,33 @@ enum Alignment { ALIGN_LEFT, ALIGN_CENTER };
 
 // Constantes de Áudio
 const std::string AUDIO_DIR = "assets/audio/";
+const std::string AUDIO_PACK =
+    "assets/audio.pak"; // Pacote gerado pelo build a partir de AUDIO_DIR
+
+// Buffer de saída do mixer (frames a 44.1 kHz)
+const int AUDIO_FREQUENCY = 44100;
+const int AUDIO_DEFAULT_BUFFER_FRAMES = 2048; // ~46 ms
+const int AUDIO_LOW_LATENCY_BUFFER_FRAMES = 256; // ~6 ms
+const int AUDIO_UNDERRUN_WINDOW_MS = 5000; // Janela de contagem de underruns
+const int AUDIO_UNDERRUN_FALLBACK_THRESHOLD =
+    3; // Underruns na janela para dobrar o buffer
+
+// Cache de músicas pré-decodificadas e transições
+const std::string PCM_CACHE_DIR = ".cache/pcm/";
+const size_t MUSIC_PCM_CACHE_MAX_SOURCE_BYTES =
+    2 * 1024 * 1024; // Músicas maiores tocam em stream
+const int MUSIC_CROSSFADE_MS = 600; // Duração do crossfade entre músicas
+// Das músicas em stream só o começo vira PCM: o crossfade e uma margem para
+// a passagem ao stream, que segue da mesma posição
+const int MUSIC_STREAM_INTRO_MS = MUSIC_CROSSFADE_MS + 1400;
+const int MUSIC_HANDOVER_FADE_MS = 30; // Emenda do PCM com o stream
+const int MUSIC_PCM_CHANNELS = 2;   // Canais reservados para o crossfade
+const int AUDIO_MIXER_CHANNELS = 16;
+const int SOUND_DEFAULT_PRIORITY = 1;
+const int SOUND_DEFAULT_MAX_INSTANCES = 4;
 
 // Arquivos de música
 const std::string MUSIC_MENU = AUDIO_DIR + "menu_theme.ogg";
-const std::string MUSIC_GAMEPLAY = AUDIO_DIR + "gameplay_theme.ogg";
 const std::string MUSIC_GAMEOVER = AUDIO_DIR + "gameover_theme.wav";
 
 // Arquivos de efeitos sonoros
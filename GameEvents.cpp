@@ -0,0 +1,13 @@
+#include "GameEvents.h"
+
+void GameEventQueue::push(GameEventType type, WASTE_TYPE wasteType,
+                          int value) {
+  if (count >= MAX_GAME_EVENTS_PER_TICK) {
+    dropped++;
+    return;
+  }
+  events[count].type = type;
+  events[count].wasteType = wasteType;
+  events[count].value = value;
+  count++;
+}
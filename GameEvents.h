@@ -0,0 +1,36 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include "GameConstants.h"
+
+// Eventos emitidos pela simulação e consumidos uma vez por frame por
+// áudio, título/HUD e persistência
+enum GameEventType {
+  EVENT_COLLECT_CORRECT,
+  EVENT_COLLECT_WRONG,
+  EVENT_MISS,
+  EVENT_LEVEL_UP,
+  EVENT_GAME_OVER
+};
+
+struct GameEvent {
+  GameEventType type;
+  WASTE_TYPE wasteType; // Tipo do objeto envolvido (coletas e erros)
+  int value;            // Pontuação, nível ou erros, conforme o tipo
+};
+
+const int MAX_GAME_EVENTS_PER_TICK =
+    64; // Capacidade da fila (bem acima do pior caso de um tick)
+
+// Fila pré-alocada; push() nunca aloca memória
+struct GameEventQueue {
+  GameEvent events[MAX_GAME_EVENTS_PER_TICK];
+  int count;
+  int dropped; // Eventos perdidos por fila cheia
+
+  GameEventQueue() : count(0), dropped(0) {}
+  void push(GameEventType type, WASTE_TYPE wasteType, int value);
+  void clear() { count = 0; }
+};
+
+#endif // GAME_EVENTS_H
@@ -3,7 +3,19 @@
 
 // Funções principais do loop do jogo
 void display();
-void update(int value);
+void renderTimer(int value);
 void reshape(int w, int h);
 
+// Medição do tempo de inicialização até o primeiro frame
+void markStartupTime();
+
+// Qualidade visual: automática (-1) ou fixa em um nível (--quality N)
+void setFixedQuality(int level);
+void toggleProfilerOverlay(); // F3
+
+// Captura de tela (F12) e gravação (F11 ou --record ARQUIVO.y4m)
+void requestScreenshot();
+void toggleRecording();
+void startRecording(const char *filename);
+
 #endif // GAME_LOOP_H
@@ -1,5 +1,8 @@
 #include "GameObjects.h"
+#include "GlStats.h"
+#include "RenderQueue.h"
 #include "TextRenderer.h"
+#include "World.h"
 #include <GL/glut.h>
 #include <algorithm>
 #include <cmath>
@@ -47,53 +50,62 @@ void Button::draw() const {
 }
 
 // Implementação do FallingObject
-FallingObject::FallingObject() {
-  size = 0.12f;
-  respawn();
+FallingObject::FallingObject(World &world) {
+  size = world.objectSize();
+  respawn(world);
 }
 
-void FallingObject::respawn() {
-  extern float currentMinObjectSpeed;
-  extern std::vector<FallingObject> objects;
+// Procura conflito só entre os objetos mais novos: em ordem de spawn,
+// cada objeto está acima do anterior, então o laço para no primeiro que já
+// desceu abaixo da faixa de spawn
+static bool isSpawnFree(const World &world, float x, float y) {
+  const float minDist = world.spawnDistance();
+  const float minDistSq = minDist * minDist;
+  for (size_t k = world.objects.size(); k-- > 0;) {
+    const FallingObject &obj = world.objects[k];
+    if (obj.y < y - minDist) {
+      break;
+    }
+    float dx = x - obj.x, dy = y - obj.y;
+    if (dx * dx + dy * dy < minDistSq) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // Registra o tempo de spawn
-  spawnTime = static_cast<float>(glutGet(GLUT_ELAPSED_TIME)) / 1000.0f;
+void FallingObject::respawn(World &world) {
+  // Registra o tempo de spawn (relógio da simulação)
+  spawnTime = world.time;
 
-  // Evita spawn muito próximo de outros objetos
+  // Faixas em x: começa numa faixa sorteada e tenta as seguintes; a
+  // posição dentro da faixa e a altura variam um pouco para não parecer
+  // uma grade
+  const int lanes = world.laneCount();
+  const float laneWidth = 1.8f / lanes;
+  int firstLane = world.randomInt(lanes);
   bool validPosition = false;
-  int attempts = 0;
-  while (!validPosition && attempts < 10) {
-    x = (static_cast<float>(rand()) / RAND_MAX) * 1.8f -
-        0.9f; // Área mais restrita
-    y = 1.0f + (static_cast<float>(rand()) / RAND_MAX) * 0.3f;
-
-    validPosition = true;
-    for (const auto &obj : objects) {
-      if (&obj != this) {
-        float dist =
-            sqrt((x - obj.x) * (x - obj.x) + (y - obj.y) * (y - obj.y));
-        if (dist < 0.3f) { // Distância mínima entre objetos
-          validPosition = false;
-          break;
-        }
-      }
-    }
-    attempts++;
+  for (int k = 0; k < lanes && !validPosition; ++k) {
+    lane = (firstLane + k) % lanes;
+    x = -0.9f + (lane + 0.25f + world.randomFloat() * 0.5f) * laneWidth;
+    y = 1.0f + world.randomFloat() * 0.3f;
+    validPosition = isSpawnFree(world, x, y);
   }
 
-  // Se não encontrou posição válida, usa posição aleatória normal
+  // Todas as faixas ocupadas: entra acima do objeto mais novo, que é o
+  // mais alto
   if (!validPosition) {
-    x = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
-    y = 1.0f + (static_cast<float>(rand()) / RAND_MAX) * 0.5f;
+    lane = firstLane;
+    x = -0.9f + (lane + 0.5f) * laneWidth;
+    y = std::max(1.0f, world.objects.back().y + world.spawnDistance());
   }
 
   // Velocidade baseada no tempo de spawn para garantir ordem
   // Objetos spawned mais tarde nunca podem ultrapassar os anteriores
-  float baseSpeed = currentMinObjectSpeed;
+  float baseSpeed = world.minObjectSpeed;
 
   // Pequena variação apenas para naturalidade visual (±2%)
-  float speedVariation =
-      (static_cast<float>(rand()) / RAND_MAX) * 0.04f - 0.02f; // -2% a +2%
+  float speedVariation = world.randomFloat() * 0.04f - 0.02f; // -2% a +2%
   speed = baseSpeed * (1.0f + speedVariation);
 
   // Garantia adicional: velocidade nunca pode exceder a velocidade base
@@ -102,181 +114,304 @@ void FallingObject::respawn() {
     speed = baseSpeed * 1.01f;
   }
 
-  rotation = static_cast<float>(rand() % 360);
-  rotationSpeed = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 1.5f *
-                  speed * 80.0f; // Rotação menos agressiva
-  wasteType = static_cast<WASTE_TYPE>(rand() % WASTE_TYPE_COUNT);
+  rotation = static_cast<float>(world.randomInt(360));
+  rotationSpeed = (world.randomFloat() - 0.5f) * 1.5f * speed *
+                  80.0f; // Rotação menos agressiva
+  wasteType = static_cast<WASTE_TYPE>(world.randomInt(WASTE_TYPE_COUNT));
 }
 
-void FallingObject::update() {
-  extern std::vector<FallingObject> objects;
-
-  // Movimento básico
-  y -= speed;
-  rotation += rotationSpeed;
+void FallingObject::update(const FallingObject *previous, float steps) {
+  // Movimento básico (speed é por tick de SIMULATION_TICK_MS)
+  y -= speed * steps;
+  rotation += rotationSpeed * steps;
 
   // Failsafe: garantir que objetos spawned depois nunca ultrapassem os
-  // anteriores
-  for (const auto &other : objects) {
-    if (&other != this && other.spawnTime < spawnTime) {
-      // Se este objeto (spawned depois) está na mesma altura ou mais baixo
-      // que um objeto spawned antes, ajusta a posição
-      if (y <= other.y) {
-        y = other.y + 0.01f; // Mantém uma pequena distância
-      }
-    }
+  // anteriores. O anterior já foi atualizado neste tick e está acima de
+  // todos os mais antigos, então basta olhar para ele.
+  if (previous != nullptr && y <= previous->y) {
+    y = previous->y + 0.01f; // Mantém uma pequena distância
   }
 }
 
-void FallingObject::draw() {
-  glPushMatrix();
-  glTranslatef(x, y, 0.0f);
-  glRotatef(rotation, 0.0f, 0.0f, 1.0f);
-  glScalef(size, size, 1.0f);
-
-  switch (wasteType) {
+// Contorno e cor de cada tipo no LOD mais simples: um quadrado só, na cor
+// dominante da forma completa
+static const GLfloat WASTE_QUAD_BOUNDS[WASTE_TYPE_COUNT][4] = {
+    {-0.5f, -0.2f, 0.5f, 0.2f},   // PAPER
+    {-0.25f, -0.5f, 0.25f, 0.5f}, // PLASTIC
+    {-0.3f, -0.5f, 0.3f, 0.5f},   // METAL
+    {-0.25f, -0.5f, 0.25f, 0.5f}, // GLASS
+    {-0.4f, -0.5f, 0.4f, 0.5f},   // ORGANIC
+};
+static const GLfloat WASTE_QUAD_COLORS[WASTE_TYPE_COUNT][4] = {
+    {0.9f, 0.9f, 0.85f, 1.0f}, // PAPER
+    {0.8f, 0.2f, 0.2f, 1.0f},  // PLASTIC
+    {0.75f, 0.75f, 0.8f, 1.0f}, // METAL
+    {0.2f, 0.7f, 0.2f, 0.7f},  // GLASS
+    {0.9f, 0.1f, 0.1f, 1.0f},  // ORGANIC
+};
+
+// Forma completa de cada tipo, em coordenadas de [-0.5, 0.5]
+static void drawFullWasteShape(RenderQueue &queue, WASTE_TYPE type) {
+  switch (type) {
   case PAPER:
-    glColor3f(0.9f, 0.9f, 0.85f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.5f, -0.2f);
-    glVertex2f(0.5f, -0.2f);
-    glVertex2f(0.5f, 0.2f);
-    glVertex2f(-0.5f, 0.2f);
-    glEnd();
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_LINES);
+    queue.color(0.9f, 0.9f, 0.85f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.5f, -0.2f);
+    queue.vertex(0.5f, -0.2f);
+    queue.vertex(0.5f, 0.2f);
+    queue.vertex(-0.5f, 0.2f);
+    queue.end();
+    queue.color(0.4f, 0.4f, 0.4f);
+    queue.begin(GL_LINES);
     for (int i = 0; i < 4; ++i) {
       float lineY = -0.15f + i * 0.1f;
-      glVertex2f(-0.4f, lineY);
-      glVertex2f(0.4f, lineY);
+      queue.vertex(-0.4f, lineY);
+      queue.vertex(0.4f, lineY);
     }
-    glEnd();
+    queue.end();
     break;
   case PLASTIC:
-    glBegin(GL_QUADS);
-    glColor3f(0.8f, 0.2f, 0.2f);
-    glVertex2f(-0.25f, -0.5f);
-    glVertex2f(0.25f, -0.5f);
-    glColor3f(1.0f, 0.5f, 0.5f);
-    glVertex2f(0.25f, 0.2f);
-    glVertex2f(-0.25f, 0.2f);
-    glEnd();
-    glBegin(GL_QUADS);
-    glVertex2f(-0.15f, 0.2f);
-    glVertex2f(0.15f, 0.2f);
-    glVertex2f(0.15f, 0.4f);
-    glVertex2f(-0.15f, 0.4f);
-    glEnd();
-    glColor3f(0.6f, 0.1f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.17f, 0.4f);
-    glVertex2f(0.17f, 0.4f);
-    glVertex2f(0.17f, 0.5f);
-    glVertex2f(-0.17f, 0.5f);
-    glEnd();
-    glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.2f, -0.3f);
-    glVertex2f(-0.1f, -0.3f);
-    glVertex2f(-0.1f, 0.1f);
-    glVertex2f(-0.2f, 0.1f);
-    glEnd();
+    queue.begin(GL_QUADS);
+    queue.color(0.8f, 0.2f, 0.2f);
+    queue.vertex(-0.25f, -0.5f);
+    queue.vertex(0.25f, -0.5f);
+    queue.color(1.0f, 0.5f, 0.5f);
+    queue.vertex(0.25f, 0.2f);
+    queue.vertex(-0.25f, 0.2f);
+    queue.end();
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.15f, 0.2f);
+    queue.vertex(0.15f, 0.2f);
+    queue.vertex(0.15f, 0.4f);
+    queue.vertex(-0.15f, 0.4f);
+    queue.end();
+    queue.color(0.6f, 0.1f, 0.1f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.17f, 0.4f);
+    queue.vertex(0.17f, 0.4f);
+    queue.vertex(0.17f, 0.5f);
+    queue.vertex(-0.17f, 0.5f);
+    queue.end();
+    queue.color(1.0f, 1.0f, 1.0f, 0.5f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.2f, -0.3f);
+    queue.vertex(-0.1f, -0.3f);
+    queue.vertex(-0.1f, 0.1f);
+    queue.vertex(-0.2f, 0.1f);
+    queue.end();
     break;
   case METAL:
     // --- INÍCIO DA ALTERAÇÃO ---
     // Lata de metal com faixa amarela para diferenciação
-    glBegin(GL_QUAD_STRIP);
-    glColor3f(0.6f, 0.6f, 0.65f);
-    glVertex2f(-0.3f, -0.5f);
-    glVertex2f(-0.3f, 0.5f);
-    glColor3f(0.9f, 0.9f, 0.95f);
-    glVertex2f(-0.1f, -0.5f);
-    glVertex2f(-0.1f, 0.5f);
-    glColor3f(0.9f, 0.9f, 0.95f);
-    glVertex2f(0.1f, -0.5f);
-    glVertex2f(0.1f, 0.5f);
-    glColor3f(0.6f, 0.6f, 0.65f);
-    glVertex2f(0.3f, -0.5f);
-    glVertex2f(0.3f, 0.5f);
-    glEnd();
+    queue.begin(GL_QUAD_STRIP);
+    queue.color(0.6f, 0.6f, 0.65f);
+    queue.vertex(-0.3f, -0.5f);
+    queue.vertex(-0.3f, 0.5f);
+    queue.color(0.9f, 0.9f, 0.95f);
+    queue.vertex(-0.1f, -0.5f);
+    queue.vertex(-0.1f, 0.5f);
+    queue.color(0.9f, 0.9f, 0.95f);
+    queue.vertex(0.1f, -0.5f);
+    queue.vertex(0.1f, 0.5f);
+    queue.color(0.6f, 0.6f, 0.65f);
+    queue.vertex(0.3f, -0.5f);
+    queue.vertex(0.3f, 0.5f);
+    queue.end();
     // Bordas superior e inferior
-    glColor3f(0.5f, 0.5f, 0.55f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.3f, 0.5f);
-    glVertex2f(0.3f, 0.5f);
-    glVertex2f(0.3f, 0.4f);
-    glVertex2f(-0.3f, 0.4f);
-    glVertex2f(-0.3f, -0.5f);
-    glVertex2f(0.3f, -0.5f);
-    glVertex2f(0.3f, -0.4f);
-    glVertex2f(-0.3f, -0.4f);
-    glEnd();
+    queue.color(0.5f, 0.5f, 0.55f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.3f, 0.5f);
+    queue.vertex(0.3f, 0.5f);
+    queue.vertex(0.3f, 0.4f);
+    queue.vertex(-0.3f, 0.4f);
+    queue.vertex(-0.3f, -0.5f);
+    queue.vertex(0.3f, -0.5f);
+    queue.vertex(0.3f, -0.4f);
+    queue.vertex(-0.3f, -0.4f);
+    queue.end();
     // Faixa amarela
-    glColor3f(0.9f, 0.8f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.32f, 0.25f);
-    glVertex2f(0.32f, 0.25f);
-    glVertex2f(0.32f, -0.05f);
-    glVertex2f(-0.32f, -0.05f);
-    glEnd();
+    queue.color(0.9f, 0.8f, 0.1f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.32f, 0.25f);
+    queue.vertex(0.32f, 0.25f);
+    queue.vertex(0.32f, -0.05f);
+    queue.vertex(-0.32f, -0.05f);
+    queue.end();
     // --- FIM DA ALTERAÇÃO ---
     break;
   case GLASS:
-    glColor4f(0.2f, 0.7f, 0.2f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.25f, -0.5f);
-    glVertex2f(0.25f, -0.5f);
-    glVertex2f(0.25f, 0.1f);
-    glVertex2f(-0.25f, 0.1f);
-    glEnd();
-    glBegin(GL_TRIANGLES);
-    glVertex2f(-0.25f, 0.1f);
-    glVertex2f(0.25f, 0.1f);
-    glVertex2f(0.15f, 0.3f);
-    glVertex2f(-0.25f, 0.1f);
-    glVertex2f(-0.15f, 0.3f);
-    glVertex2f(0.15f, 0.3f);
-    glEnd();
-    glBegin(GL_QUADS);
-    glVertex2f(-0.1f, 0.3f);
-    glVertex2f(0.1f, 0.3f);
-    glVertex2f(0.1f, 0.5f);
-    glVertex2f(-0.1f, 0.5f);
-    glEnd();
-    glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
-    glBegin(GL_QUADS);
-    glVertex2f(0.1f, -0.4f);
-    glVertex2f(0.18f, -0.4f);
-    glVertex2f(0.18f, 0.2f);
-    glVertex2f(0.1f, 0.2f);
-    glEnd();
+    queue.color(0.2f, 0.7f, 0.2f, 0.7f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.25f, -0.5f);
+    queue.vertex(0.25f, -0.5f);
+    queue.vertex(0.25f, 0.1f);
+    queue.vertex(-0.25f, 0.1f);
+    queue.end();
+    queue.begin(GL_TRIANGLES);
+    queue.vertex(-0.25f, 0.1f);
+    queue.vertex(0.25f, 0.1f);
+    queue.vertex(0.15f, 0.3f);
+    queue.vertex(-0.25f, 0.1f);
+    queue.vertex(-0.15f, 0.3f);
+    queue.vertex(0.15f, 0.3f);
+    queue.end();
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.1f, 0.3f);
+    queue.vertex(0.1f, 0.3f);
+    queue.vertex(0.1f, 0.5f);
+    queue.vertex(-0.1f, 0.5f);
+    queue.end();
+    queue.color(1.0f, 1.0f, 1.0f, 0.6f);
+    queue.begin(GL_QUADS);
+    queue.vertex(0.1f, -0.4f);
+    queue.vertex(0.18f, -0.4f);
+    queue.vertex(0.18f, 0.2f);
+    queue.vertex(0.1f, 0.2f);
+    queue.end();
     break;
   case ORGANIC:
-    glBegin(GL_POLYGON);
-    glColor3f(0.9f, 0.1f, 0.1f);
+    queue.begin(GL_POLYGON);
+    queue.color(0.9f, 0.1f, 0.1f);
     for (int i = 0; i < 20; i++) {
       float ang = 2.0f * M_PI * i / 20.0f;
-      glVertex2f(cos(ang) * 0.4f, sin(ang) * 0.5f);
+      queue.vertex(cos(ang) * 0.4f, sin(ang) * 0.5f);
+    }
+    queue.end();
+    queue.color(0.4f, 0.2f, 0.0f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.05f, 0.4f);
+    queue.vertex(0.05f, 0.4f);
+    queue.vertex(0.05f, 0.6f);
+    queue.vertex(-0.05f, 0.6f);
+    queue.end();
+    queue.color(0.1f, 0.8f, 0.1f);
+    queue.begin(GL_TRIANGLES);
+    queue.vertex(0.05f, 0.5f);
+    queue.vertex(0.3f, 0.7f);
+    queue.vertex(0.1f, 0.4f);
+    queue.end();
+    break;
+  default:
+    break;
+  }
+}
+
+// Silhueta reconhecível com poucos vértices: sem linhas, reflexos nem
+// gradientes, e a maçã com 8 lados em vez de 20
+static void drawReducedWasteShape(RenderQueue &queue, WASTE_TYPE type) {
+  switch (type) {
+  case PAPER:
+    queue.color(0.9f, 0.9f, 0.85f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.5f, -0.2f);
+    queue.vertex(0.5f, -0.2f);
+    queue.vertex(0.5f, 0.2f);
+    queue.vertex(-0.5f, 0.2f);
+    queue.end();
+    break;
+  case PLASTIC:
+    queue.color(0.8f, 0.2f, 0.2f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.25f, -0.5f);
+    queue.vertex(0.25f, -0.5f);
+    queue.vertex(0.25f, 0.2f);
+    queue.vertex(-0.25f, 0.2f);
+    queue.vertex(-0.15f, 0.2f);
+    queue.vertex(0.15f, 0.2f);
+    queue.vertex(0.15f, 0.5f);
+    queue.vertex(-0.15f, 0.5f);
+    queue.end();
+    break;
+  case METAL:
+    queue.begin(GL_QUADS);
+    queue.color(0.75f, 0.75f, 0.8f);
+    queue.vertex(-0.3f, -0.5f);
+    queue.vertex(0.3f, -0.5f);
+    queue.vertex(0.3f, 0.5f);
+    queue.vertex(-0.3f, 0.5f);
+    queue.color(0.9f, 0.8f, 0.1f);
+    queue.vertex(-0.32f, 0.25f);
+    queue.vertex(0.32f, 0.25f);
+    queue.vertex(0.32f, -0.05f);
+    queue.vertex(-0.32f, -0.05f);
+    queue.end();
+    break;
+  case GLASS:
+    queue.color(0.2f, 0.7f, 0.2f, 0.7f);
+    queue.begin(GL_QUADS);
+    queue.vertex(-0.25f, -0.5f);
+    queue.vertex(0.25f, -0.5f);
+    queue.vertex(0.25f, 0.2f);
+    queue.vertex(-0.25f, 0.2f);
+    queue.vertex(-0.1f, 0.2f);
+    queue.vertex(0.1f, 0.2f);
+    queue.vertex(0.1f, 0.5f);
+    queue.vertex(-0.1f, 0.5f);
+    queue.end();
+    break;
+  case ORGANIC:
+    queue.color(0.9f, 0.1f, 0.1f);
+    queue.begin(GL_POLYGON);
+    for (int i = 0; i < 8; i++) {
+      float ang = 2.0f * M_PI * i / 8.0f;
+      queue.vertex(cos(ang) * 0.4f, sin(ang) * 0.5f);
     }
-    glEnd();
-    glColor3f(0.4f, 0.2f, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.05f, 0.4f);
-    glVertex2f(0.05f, 0.4f);
-    glVertex2f(0.05f, 0.6f);
-    glVertex2f(-0.05f, 0.6f);
-    glEnd();
-    glColor3f(0.1f, 0.8f, 0.1f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(0.05f, 0.5f);
-    glVertex2f(0.3f, 0.7f);
-    glVertex2f(0.1f, 0.4f);
-    glEnd();
+    queue.end();
+    break;
+  default:
+    break;
+  }
+}
+
+static void drawWasteQuad(RenderQueue &queue, WASTE_TYPE type) {
+  const GLfloat *b = WASTE_QUAD_BOUNDS[type];
+  queue.color(WASTE_QUAD_COLORS[type]);
+  queue.begin(GL_QUADS);
+  queue.vertex(b[0], b[1]);
+  queue.vertex(b[2], b[1]);
+  queue.vertex(b[2], b[3]);
+  queue.vertex(b[0], b[3]);
+  queue.end();
+}
+
+// Forma de um tipo de lixo já posicionada, girada e escalada pelo chamador
+static void drawWasteShape(RenderQueue &queue, WASTE_TYPE type,
+                           WasteLod lod) {
+  switch (lod) {
+  case WASTE_LOD_FULL:
+    drawFullWasteShape(queue, type);
+    break;
+  case WASTE_LOD_REDUCED:
+    drawReducedWasteShape(queue, type);
     break;
   default:
+    drawWasteQuad(queue, type);
     break;
   }
-  glPopMatrix();
+}
+
+WasteLod selectWasteLod(float size, float visibility, const LodContext &ctx) {
+  float pixels = size * ctx.pixelsPerUnit;
+  int lod = pixels >= WASTE_LOD_FULL_PIXELS      ? WASTE_LOD_FULL
+            : pixels >= WASTE_LOD_REDUCED_PIXELS ? WASTE_LOD_REDUCED
+                                                 : WASTE_LOD_QUAD;
+  // Atrás de um overlay escuro os detalhes não aparecem
+  if (visibility < 0.25f) {
+    lod = WASTE_LOD_QUAD;
+  } else if (visibility < 0.5f) {
+    lod++;
+  }
+  lod += ctx.bias;
+  return static_cast<WasteLod>(std::min(lod, static_cast<int>(WASTE_LOD_QUAD)));
+}
+
+void FallingObject::draw(RenderQueue &queue, WasteLod lod) {
+  queue.pushMatrix();
+  queue.translate(x, y);
+  queue.rotate(rotation);
+  queue.scale(size, size);
+  drawWasteShape(queue, wasteType, lod);
+  queue.popMatrix();
 }
 
 // Implementação do Basket
@@ -289,7 +424,7 @@ Basket::Basket() {
   speed = 0.05f;
 }
 
-void Basket::draw() {
+void Basket::draw(RenderQueue &queue) {
   // A definição de COLOR_TABLE não está neste arquivo.
   // Supondo que ela seja definida em outro lugar e acessível.
   extern const GLfloat COLOR_TABLE[5][3];
@@ -297,47 +432,45 @@ void Basket::draw() {
   const float *color = COLOR_TABLE[wasteType];
 
   // Corpo da cesta com gradiente
-  glBegin(GL_QUADS);
-  glColor3f(color[0] * 0.7f, color[1] * 0.7f, color[2] * 0.7f);
-  glVertex2f(-width / 2, -height / 2);
-  glVertex2f(width / 2, -height / 2);
-  glColor3f(color[0], color[1], color[2]);
-  glVertex2f(width / 2, height / 2);
-  glVertex2f(-width / 2, height / 2);
-  glEnd();
+  queue.begin(GL_QUADS);
+  queue.color(color[0] * 0.7f, color[1] * 0.7f, color[2] * 0.7f);
+  queue.vertex(-width / 2, -height / 2);
+  queue.vertex(width / 2, -height / 2);
+  queue.color(color[0], color[1], color[2]);
+  queue.vertex(width / 2, height / 2);
+  queue.vertex(-width / 2, height / 2);
+  queue.end();
 
   // Borda superior da cesta
-  glColor3f(color[0] * 0.5f, color[1] * 0.5f, color[2] * 0.5f);
-  glBegin(GL_QUADS);
-  glVertex2f(-width / 2 - 0.02f, height / 2);
-  glVertex2f(width / 2 + 0.02f, height / 2);
-  glVertex2f(width / 2 + 0.02f, height / 2 + 0.03f);
-  glVertex2f(-width / 2 - 0.02f, height / 2 + 0.03f);
-  glEnd();
+  queue.color(color[0] * 0.5f, color[1] * 0.5f, color[2] * 0.5f);
+  queue.begin(GL_QUADS);
+  queue.vertex(-width / 2 - 0.02f, height / 2);
+  queue.vertex(width / 2 + 0.02f, height / 2);
+  queue.vertex(width / 2 + 0.02f, height / 2 + 0.03f);
+  queue.vertex(-width / 2 - 0.02f, height / 2 + 0.03f);
+  queue.end();
 
 // Símbolo de reciclagem
-    glPushMatrix();
-  glColor3f(1.0f, 1.0f, 1.0f);
+    queue.pushMatrix();
+  queue.color(1.0f, 1.0f, 1.0f);
   
   // Reduz a escala do símbolo para 80% para que ele caiba na cesta
-  glScalef(0.8f, 0.8f, 1.0f); 
+  queue.scale(0.8f, 0.8f); 
 
   float s = 0.05f;
   for (int i = 0; i < 3; ++i) {
-    glRotatef(120.0, 0, 0, 1);
-    glBegin(GL_QUADS);
-    glVertex2f(-s, s);
-    glVertex2f(s, s);
-    glVertex2f(s * 1.5, s * 1.8);
-    glVertex2f(-s * 0.5, s * 1.8);
-    glEnd();
+    queue.rotate(120.0);
+    queue.begin(GL_QUADS);
+    queue.vertex(-s, s);
+    queue.vertex(s, s);
+    queue.vertex(s * 1.5, s * 1.8);
+    queue.vertex(-s * 0.5, s * 1.8);
+    queue.end();
   }
-  glPopMatrix();
+  queue.popMatrix();
 }
 
-void Basket::move(float direction) {
-  extern float difficultyMultiplier;
-
+void Basket::move(float direction, float difficultyMultiplier) {
   // Velocidade da cesta aumenta ligeiramente com a dificuldade para compensar
   float adjustedSpeed = speed * (1.0f + difficultyMultiplier * 0.1f);
 
@@ -350,154 +483,83 @@ void Basket::move(float direction) {
   }
 }
 
+static int16_t quantizePosition(float v) {
+  long q = lround(v * SETTLED_POSITION_SCALE);
+  return static_cast<int16_t>(std::max(-32768L, std::min(32767L, q)));
+}
+
+SettledParticle packSettledParticle(const TrashParticle &p) {
+  SettledParticle s;
+  s.x = quantizePosition(p.x);
+  s.y = quantizePosition(p.y);
+  float degrees = fmodf(p.rotation, 360.0f);
+  if (degrees < 0.0f) {
+    degrees += 360.0f;
+  }
+  s.rotation = static_cast<uint8_t>(lroundf(degrees * (256.0f / 360.0f)));
+  s.size = static_cast<uint8_t>(
+      std::min(255L, lround(p.size * SETTLED_SIZE_SCALE)));
+  s.type = static_cast<uint8_t>(p.type);
+  s.unused = 0;
+  return s;
+}
+
+TrashParticle unpackSettledParticle(const SettledParticle &s) {
+  TrashParticle p;
+  p.x = s.getX();
+  p.y = s.getY();
+  p.vx = p.vy = 0.0f;
+  p.rotation = s.getRotation();
+  p.rotationSpeed = 0.0f;
+  p.size = p.largura = p.altura = s.getSize();
+  p.estatico = true;
+  p.type = static_cast<WASTE_TYPE>(s.type);
+  return p;
+}
+
+void drawSettledParticle(RenderQueue &queue, const SettledParticle &p,
+                         WasteLod lod) {
+  float size = p.getSize();
+  queue.pushMatrix();
+  queue.translate(p.getX(), p.getY());
+  queue.rotate(p.getRotation());
+  queue.scale(size, size);
+  drawWasteShape(queue, static_cast<WASTE_TYPE>(p.type), lod);
+  queue.popMatrix();
+}
+
 // Implementação da função drawRainObject
-void drawRainObject(const TrashParticle &p) {
-  glPushMatrix();
-  glTranslatef(p.x, p.y, 0.0f);
-  glRotatef(p.rotation, 0.0f, 0.0f, 1.0f);
-  glScalef(p.size, p.size, 1.0f);
+void drawRainObject(RenderQueue &queue, const TrashParticle &p,
+                    WasteLod lod) {
+  queue.pushMatrix();
+  queue.translate(p.x, p.y);
+  queue.rotate(p.rotation);
+  queue.scale(p.size, p.size);
+  drawWasteShape(queue, p.type, lod);
+  queue.popMatrix();
+}
 
-  switch (p.type) {
-  case PAPER:
-    glColor3f(0.9f, 0.9f, 0.85f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.5f, -0.2f);
-    glVertex2f(0.5f, -0.2f);
-    glVertex2f(0.5f, 0.2f);
-    glVertex2f(-0.5f, 0.2f);
-    glEnd();
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_LINES);
-    for (int i = 0; i < 4; ++i) {
-      float lineY = -0.15f + i * 0.1f;
-      glVertex2f(-0.4f, lineY);
-      glVertex2f(0.4f, lineY);
-    }
-    glEnd();
-    break;
-  case PLASTIC:
-    glBegin(GL_QUADS);
-    glColor3f(0.8f, 0.2f, 0.2f);
-    glVertex2f(-0.25f, -0.5f);
-    glVertex2f(0.25f, -0.5f);
-    glColor3f(1.0f, 0.5f, 0.5f);
-    glVertex2f(0.25f, 0.2f);
-    glVertex2f(-0.25f, 0.2f);
-    glEnd();
-    glBegin(GL_QUADS);
-    glVertex2f(-0.15f, 0.2f);
-    glVertex2f(0.15f, 0.2f);
-    glVertex2f(0.15f, 0.4f);
-    glVertex2f(-0.15f, 0.4f);
-    glEnd();
-    glColor3f(0.6f, 0.1f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.17f, 0.4f);
-    glVertex2f(0.17f, 0.4f);
-    glVertex2f(0.17f, 0.5f);
-    glVertex2f(-0.17f, 0.5f);
-    glEnd();
-    glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.2f, -0.3f);
-    glVertex2f(-0.1f, -0.3f);
-    glVertex2f(-0.1f, 0.1f);
-    glVertex2f(-0.2f, 0.1f);
-    glEnd();
-    break;
-  case METAL:
-    // --- INÍCIO DA ALTERAÇÃO ---
-    // Lata de metal com faixa amarela para diferenciação
-    glBegin(GL_QUAD_STRIP);
-    glColor3f(0.6f, 0.6f, 0.65f);
-    glVertex2f(-0.3f, -0.5f);
-    glVertex2f(-0.3f, 0.5f);
-    glColor3f(0.9f, 0.9f, 0.95f);
-    glVertex2f(-0.1f, -0.5f);
-    glVertex2f(-0.1f, 0.5f);
-    glColor3f(0.9f, 0.9f, 0.95f);
-    glVertex2f(0.1f, -0.5f);
-    glVertex2f(0.1f, 0.5f);
-    glColor3f(0.6f, 0.6f, 0.65f);
-    glVertex2f(0.3f, -0.5f);
-    glVertex2f(0.3f, 0.5f);
-    glEnd();
-    // Bordas superior e inferior
-    glColor3f(0.5f, 0.5f, 0.55f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.3f, 0.5f);
-    glVertex2f(0.3f, 0.5f);
-    glVertex2f(0.3f, 0.4f);
-    glVertex2f(-0.3f, 0.4f);
-    glVertex2f(-0.3f, -0.5f);
-    glVertex2f(0.3f, -0.5f);
-    glVertex2f(0.3f, -0.4f);
-    glVertex2f(-0.3f, -0.4f);
-    glEnd();
-    // Faixa amarela
-    glColor3f(0.9f, 0.8f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.32f, 0.25f);
-    glVertex2f(0.32f, 0.25f);
-    glVertex2f(0.32f, -0.05f);
-    glVertex2f(-0.32f, -0.05f);
-    glEnd();
-    // --- FIM DA ALTERAÇÃO ---
-    break;
-  case GLASS:
-    glColor4f(0.2f, 0.7f, 0.2f, 0.7f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.25f, -0.5f);
-    glVertex2f(0.25f, -0.5f);
-    glVertex2f(0.25f, 0.1f);
-    glVertex2f(-0.25f, 0.1f);
-    glEnd();
-    glBegin(GL_TRIANGLES);
-    glVertex2f(-0.25f, 0.1f);
-    glVertex2f(0.25f, 0.1f);
-    glVertex2f(0.15f, 0.3f);
-    glVertex2f(-0.25f, 0.1f);
-    glVertex2f(-0.15f, 0.3f);
-    glVertex2f(0.15f, 0.3f);
-    glEnd();
-    glBegin(GL_QUADS);
-    glVertex2f(-0.1f, 0.3f);
-    glVertex2f(0.1f, 0.3f);
-    glVertex2f(0.1f, 0.5f);
-    glVertex2f(-0.1f, 0.5f);
-    glEnd();
-    glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
-    glBegin(GL_QUADS);
-    glVertex2f(0.1f, -0.4f);
-    glVertex2f(0.18f, -0.4f);
-    glVertex2f(0.18f, 0.2f);
-    glVertex2f(0.1f, 0.2f);
-    glEnd();
-    break;
-  case ORGANIC:
-    glBegin(GL_POLYGON);
-    glColor3f(0.9f, 0.1f, 0.1f);
-    for (int i = 0; i < 20; i++) {
-      float ang = 2.0f * M_PI * i / 20.0f;
-      glVertex2f(cos(ang) * 0.4f, sin(ang) * 0.5f);
-    }
-    glEnd();
-    glColor3f(0.4f, 0.2f, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(-0.05f, 0.4f);
-    glVertex2f(0.05f, 0.4f);
-    glVertex2f(0.05f, 0.6f);
-    glVertex2f(-0.05f, 0.6f);
-    glEnd();
-    glColor3f(0.1f, 0.8f, 0.1f);
-    glBegin(GL_TRIANGLES);
-    glVertex2f(0.05f, 0.5f);
-    glVertex2f(0.3f, 0.7f);
-    glVertex2f(0.1f, 0.4f);
-    glEnd();
-    break;
-  default:
-    break;
+void createHomeScreenDebris(std::vector<TrashParticle> &debris) {
+  debris.clear();
+  for (int i = 0; i < 50; ++i) {
+    TrashParticle p;
+    p.x = (static_cast<float>(rand()) / RAND_MAX) * 4.0f - 2.0f;
+    p.y = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
+    p.vx = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.01f;
+    p.vy = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.01f;
+    p.size = 0.04f + (static_cast<float>(rand()) / RAND_MAX) * 0.04f;
+    p.rotation = static_cast<float>(rand() % 360);
+    p.rotationSpeed = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.5f;
+    p.type = static_cast<WASTE_TYPE>(rand() % WASTE_TYPE_COUNT);
+    p.estatico = false;
+    debris.push_back(p);
   }
-  glPopMatrix();
-}
\ No newline at end of file
+}
+
+void createPauseButtons(std::vector<Button> &buttons) {
+  buttons.clear();
+  buttons.push_back(Button(0.0f, 0.3f, 0.8f, 0.15f, "Continuar"));
+  buttons.push_back(Button(0.0f, 0.1f, 0.8f, 0.15f, "Reiniciar"));
+  buttons.push_back(Button(0.0f, -0.1f, 0.8f, 0.15f, "Tela Inicial"));
+  buttons.push_back(Button(0.0f, -0.3f, 0.8f, 0.15f, "Sair do Jogo"));
+}
@@ -2,9 +2,23 @@
 #define GAME_OBJECTS_H
 
 #include "GameConstants.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
+struct World;
+class RenderQueue;
+
+// Níveis de detalhe das formas de lixo: completa, silhueta com poucos
+// vértices e um quadrado na cor dominante
+enum WasteLod { WASTE_LOD_FULL, WASTE_LOD_REDUCED, WASTE_LOD_QUAD };
+
+// Dados de tela para escolher o LOD de cada instância
+struct LodContext {
+  float pixelsPerUnit; // Pixels por unidade do mundo na janela atual
+  int bias;            // Níveis a mais pedidos pelo governador de qualidade
+};
+
 // Estrutura para os botões da interface (UI)
 struct Button {
   float x, y, width, height; // Posição e dimensões
@@ -23,22 +37,45 @@ struct TrashParticle {
   WASTE_TYPE type; // Tipo de lixo para definir a cor/forma
 };
 
+// Partícula da chuva que já parou. Nada nela muda depois de estatico, então
+// a pilha guarda só o que o desenho e a colisão leem, quantizado em 8
+// bytes (contra 44 da TrashParticle)
+struct SettledParticle {
+  int16_t x, y;     // Posição em ponto fixo (SETTLED_POSITION_SCALE)
+  uint8_t rotation; // Ângulo em 256 passos por volta
+  uint8_t size;     // Tamanho em ponto fixo (SETTLED_SIZE_SCALE)
+  uint8_t type;     // WASTE_TYPE (3 bits usados)
+  uint8_t unused;
+
+  float getX() const { return x / SETTLED_POSITION_SCALE; }
+  float getY() const { return y / SETTLED_POSITION_SCALE; }
+  float getSize() const { return size / SETTLED_SIZE_SCALE; }
+  float getRotation() const { return rotation * (360.0f / 256.0f); }
+};
+
+SettledParticle packSettledParticle(const TrashParticle &p);
+TrashParticle unpackSettledParticle(const SettledParticle &p);
+
 // Estrutura para os prédios do cenário
 struct Building {
   float x_pos, width, height, r, g, b;
   int layer; // Camada para efeito de paralaxe
 };
 
-// Estrutura para representar um objeto caindo
+// Estrutura para representar um objeto caindo. World::objects fica em
+// ordem de spawn: o anterior no vetor (no modo stress, o anterior da mesma
+// faixa) é o único que pode ser ultrapassado.
 struct FallingObject {
   float x, y, size, speed, rotation, rotationSpeed;
   float spawnTime;      // Tempo de spawn para manter ordem
   WASTE_TYPE wasteType; // Tipo de lixo
+  int lane;             // Faixa de spawn
 
-  FallingObject();
-  void respawn();
-  void update();
-  void draw();
+  explicit FallingObject(World &world);
+  void respawn(World &world); // Deve ir para o fim de world.objects depois
+  // previous: anterior na ordem de spawn; steps: ticks nominais do passo
+  void update(const FallingObject *previous, float steps);
+  void draw(RenderQueue &queue, WasteLod lod);
 };
 
 // Estrutura para representar a cesta coletora
@@ -47,8 +84,8 @@ struct Basket {
   WASTE_TYPE wasteType;             // Tipo de lixo que a cesta aceita
 
   Basket();
-  void draw();
-  void move(float direction);
+  void draw(RenderQueue &queue);
+  void move(float direction, float difficultyMultiplier);
 };
 
 // Estrutura para armazenar o score de um jogador no ranking
@@ -58,6 +95,16 @@ struct PlayerScore {
 };
 
 // Funções para desenhar objetos
-void drawRainObject(const TrashParticle &p);
+// LOD pelo tamanho na tela; visibility < 1 quando um overlay escuro cobre
+// a forma (0.3 = só 30% dela aparece)
+WasteLod selectWasteLod(float size, float visibility, const LodContext &ctx);
+void drawSettledParticle(RenderQueue &queue, const SettledParticle &p,
+                         WasteLod lod);
+void drawRainObject(RenderQueue &queue, const TrashParticle &p,
+                    WasteLod lod);
+
+// Conteúdo inicial das telas (GameState e o renderizador offscreen)
+void createHomeScreenDebris(std::vector<TrashParticle> &debris); // rand()
+void createPauseButtons(std::vector<Button> &buttons);
 
 #endif // GAME_OBJECTS_H
@@ -1,7 +1,10 @@
 #include "GameState.h"
+#include "AllocStats.h"
 #include "AudioManager.h"
 #include "RankingSystem.h"
-#include <GL/glut.h>
+#include "Simulation.h"
+#include "SimulationThread.h"
+#include "WorldSnapshot.h"
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -9,80 +12,176 @@
 // Definição das variáveis globais
 GameState gameState = STATE_HOME;
 std::string currentPlayerName = "Jogador";
-std::vector<FallingObject> objects;
+World world;
 std::vector<Building> cityscape;
-Basket basket;
-int score = 0;
-int misses = 0;
 int windowWidth = 600, windowHeight = 800;
-bool key_a_pressed = false, key_d_pressed = false;
 
 std::vector<Button> pauseButtons;
 Button homeButton(0.0f, -0.1f, 0.8f, 0.15f, "Iniciar");
 float mouseGameX, mouseGameY;
 
-float currentMinObjectSpeed = INITIAL_MIN_OBJECT_SPEED;
-float currentMaxObjectSpeedOffset = INITIAL_MAX_OBJECT_SPEED_OFFSET;
-int scoreForNextDifficultyIncrease = INITIAL_SCORE_FOR_DIFFICULTY;
-int currentDifficultyLevel = 1;
-int spawnDelay = SPAWN_DELAY_INITIAL;
-int spawnTimer = 0;
-float difficultyMultiplier = 1.0f;
-
-std::vector<TrashParticle> trashRain;
-float gameOverAnimationTimer = 0.0f;
-int displayedScore = 0, finalScoreHolder = 0;
-float gameOverBasketAngle = 0.0f;
-float gameOverBasketY = 0.0f;
-
 std::vector<TrashParticle> homeScreenDebris;
 float homeScreenAnimationTimer = 0.0f;
 
 std::vector<PlayerScore> ranking;
 
+int titleScore = -1;
+
+RewindBuffer rewindBuffer(REWIND_MAX_FRAMES, REWIND_MEMORY_BUDGET,
+                          REWIND_KEYFRAME_INTERVAL);
+bool rewindHeld = false;
+static bool rewinding = false; // Exibindo um quadro antigo do histórico
+static size_t rewindCursor = 0;
+
+// O título em si é trocado pela thread do GLUT ao desenhar o snapshot
 void updateWindowTitle() {
-  char title[100];
-  if (gameState == STATE_PLAYING) {
-    sprintf(title, "Coleta Seletiva - Pontos: %d", score);
-  } else {
-    sprintf(title, "Coleta Seletiva");
+  titleScore = (gameState == STATE_PLAYING) ? world.score : -1;
+}
+
+static void updateHomeScreen(float dt) {
+  // Animação da tela inicial
+  if (homeScreenAnimationTimer < HOMESCREEN_ANIMATION_DURATION) {
+    homeScreenAnimationTimer += dt;
+  }
+
+  // Move as partículas de fundo
+  for (auto &p : homeScreenDebris) {
+    p.x += p.vx * dt;
+    p.y += p.vy * dt;
+    p.rotation += p.rotationSpeed * dt;
+
+    if (p.x > 2.2f)
+      p.x = -2.2f;
+    if (p.x < -2.2f)
+      p.x = 2.2f;
+    if (p.y > 1.2f)
+      p.y = -1.2f;
+    if (p.y < -1.2f)
+      p.y = 1.2f;
   }
-  glutSetWindowTitle(title);
 }
 
-void triggerGameOver() {
-  gameState = STATE_GAMEOVER;
-  finalScoreHolder = score;
-  gameOverBasketY = basket.y;
-  saveRanking(currentPlayerName, score, ranking);
-  loadRanking(ranking);
+// Volta um tick no histórico. No game over o rewind fica restrito à
+// animação final (a pontuação já foi para o ranking)
+static void stepRewind() {
+  if (!rewinding) {
+    if (rewindBuffer.getFrameCount() == 0) {
+      return;
+    }
+    rewinding = true;
+    rewindCursor = rewindBuffer.getFrameCount() - 1;
+  }
+  if (rewindCursor == 0) {
+    return;
+  }
+  rewindBuffer.restore(rewindCursor - 1, world);
+  if (gameState == STATE_GAMEOVER && !world.gameOver) {
+    rewindBuffer.restore(rewindCursor, world);
+    return;
+  }
+  rewindCursor--;
+}
 
-  // Trocar música para game over (tocar apenas uma vez com volume alto)
-  if (audioManager.isEnabled()) {
-    audioManager.playMusicWithVolume(
-        "gameover", 64, 0); // Volume 64 (4x maior), tocar apenas uma vez
+// Soltar o Backspace: a partida segue do quadro exibido
+static void endRewind() {
+  rewinding = false;
+  rewindBuffer.truncateAfter(rewindCursor);
+  world.moveLeft = false; // As setas são lidas de novo
+  world.moveRight = false;
+  updateWindowTitle();
+}
+
+void simulateTick(float dt) {
+  if (gameState == STATE_HOME) {
+    updateHomeScreen(dt);
+  } else if (gameState == STATE_PLAYING || gameState == STATE_GAMEOVER) {
+    if (rewindHeld) {
+      stepRewind();
+      return;
+    }
+    if (rewinding) {
+      endRewind();
+    }
+    simulateWorld(world, dt);
+    rewindBuffer.capture(world);
+    if (world.gameOver) {
+      gameState = STATE_GAMEOVER;
+    }
+  }
+}
+
+static void clearRewind() {
+  rewindBuffer.clear();
+  rewindHeld = false;
+  rewinding = false;
+}
+
+// Consumidores dos eventos da simulação, chamados uma vez por frame
+static void consumeAudioEvents() {
+  if (!audioManager.isEnabled()) {
+    return;
+  }
+  // Resolvidos no primeiro tick, para as coletas não alocarem depois
+  static int collectCorrectSound = audioManager.soundId("collect_correct");
+  static int collectWrongSound = audioManager.soundId("collect_wrong");
+  for (int i = 0; i < world.events.count; ++i) {
+    switch (world.events.events[i].type) {
+    case EVENT_COLLECT_CORRECT:
+      audioManager.playSound(collectCorrectSound); // Som de coleta correta
+      break;
+    case EVENT_COLLECT_WRONG:
+      audioManager.playSound(collectWrongSound); // Som de coleta incorreta
+      break;
+    case EVENT_GAME_OVER:
+      // Trocar música para game over (tocar apenas uma vez com volume alto)
+      audioManager.playMusicWithVolume(
+          "gameover", 64, 0); // Volume 64 (4x maior), tocar apenas uma vez
+      break;
+    default:
+      break;
+    }
   }
 }
 
-void initHomeScreen() {
-  homeScreenDebris.clear();
-  for (int i = 0; i < 50; ++i) {
-    TrashParticle p;
-    p.x = (static_cast<float>(rand()) / RAND_MAX) * 4.0f - 2.0f;
-    p.y = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
-    p.vx = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.01f;
-    p.vy = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.01f;
-    p.size = 0.04f + (static_cast<float>(rand()) / RAND_MAX) * 0.04f;
-    p.rotation = static_cast<float>(rand() % 360);
-    p.rotationSpeed = ((static_cast<float>(rand()) / RAND_MAX) - 0.5f) * 0.5f;
-    p.type = static_cast<WASTE_TYPE>(rand() % WASTE_TYPE_COUNT);
-    p.estatico = false;
-    homeScreenDebris.push_back(p);
+static void consumeHudEvents() {
+  // O título muda no máximo uma vez por frame, mesmo com várias coletas
+  bool titleDirty = false;
+  for (int i = 0; i < world.events.count; ++i) {
+    GameEventType type = world.events.events[i].type;
+    if (type == EVENT_COLLECT_CORRECT || type == EVENT_GAME_OVER) {
+      titleDirty = true;
+    }
+  }
+  if (titleDirty) {
+    updateWindowTitle();
   }
 }
 
+static void consumePersistenceEvents() {
+  for (int i = 0; i < world.events.count; ++i) {
+    if (world.events.events[i].type == EVENT_GAME_OVER) {
+      allocStatsAllowFrame(); // Lê e grava o arquivo do ranking
+      saveRanking(currentPlayerName, world.events.events[i].value, ranking);
+      loadRanking(ranking);
+      discardAutosave(); // Nada mais a retomar
+    }
+  }
+}
+
+void dispatchGameEvents() {
+  consumeAudioEvents();
+  consumeHudEvents();
+  consumePersistenceEvents();
+  world.events.clear();
+}
+
+void initHomeScreen() { createHomeScreenDebris(homeScreenDebris); }
+
 void goToHomeScreen() {
+  allocStatsAllowFrame();
   gameState = STATE_HOME;
+  discardAutosave(); // Partida abandonada
+  clearRewind();
   updateWindowTitle();
   loadRanking(ranking);
   homeScreenAnimationTimer = 0.0f;
@@ -96,93 +195,44 @@ void goToHomeScreen() {
 }
 
 void resetGame() {
+  allocStatsAllowFrame();
+  bool fromHome = gameState == STATE_HOME;
   if (currentPlayerName.empty()) {
     currentPlayerName = "Jogador";
   }
 
-  score = 0;
-  misses = 0;
-  gameOverAnimationTimer = 0.0f;
-  displayedScore = 0;
-  finalScoreHolder = 0;
-  gameOverBasketAngle = 0.0f;
-  trashRain.clear();
-
-  currentMinObjectSpeed = INITIAL_MIN_OBJECT_SPEED;
-  currentMaxObjectSpeedOffset = INITIAL_MAX_OBJECT_SPEED_OFFSET;
-  scoreForNextDifficultyIncrease = INITIAL_SCORE_FOR_DIFFICULTY;
-  currentDifficultyLevel = 1;
-  spawnDelay = SPAWN_DELAY_INITIAL;
-  spawnTimer = 0;
-  difficultyMultiplier = 1.0f;
-
-  objects.clear();
-  objects.push_back(FallingObject());
-  basket.x = 0.0f;
-  basket.wasteType = PAPER;
+  world.reset();
+  discardAutosave();
+  clearRewind();
 
   gameState = STATE_PLAYING;
   updateWindowTitle();
 
-  // Trocar música para gameplay
+  // A partida usa o tema do menu, que já toca vindo da tela inicial; do
+  // game over ou da pausa ele recomeça
   if (audioManager.isEnabled()) {
     audioManager.setMusicVolume(16); // Restaurar volume normal
-    audioManager.playMusic("gameplay");
+    if (!fromHome) {
+      audioManager.playMusic("menu");
+    }
   }
 }
 
-// Funções para gerenciamento de dificuldade
-void updateDifficulty() {
-  if (score >= scoreForNextDifficultyIncrease) {
-    currentDifficultyLevel++;
-
-    // Calcula multiplicador de dificuldade com curva mais agressiva para 8
-    // níveis
-    difficultyMultiplier = 1.0f + (currentDifficultyLevel - 1) * 0.4f;
-
-    // Aumenta velocidade gradualmente com progressão mais acentuada
-    float speedBoost =
-        SPEED_INCREASE_RATE * (1.0f + currentDifficultyLevel * 0.5f);
-    if (currentMinObjectSpeed < MAX_OBJECT_SPEED) {
-      currentMinObjectSpeed += speedBoost;
-      if (currentMinObjectSpeed > MAX_OBJECT_SPEED) {
-        currentMinObjectSpeed = MAX_OBJECT_SPEED;
-      }
-    }
-
-    if (currentMaxObjectSpeedOffset < MAX_OBJECT_SPEED * 0.5f) {
-      currentMaxObjectSpeedOffset += speedBoost * 0.5f;
-    }
-
-    // Diminui delay de spawn (aumenta taxa de spawn)
-    spawnDelay = static_cast<int>(SPAWN_DELAY_INITIAL /
-                                  (1.0f + difficultyMultiplier * 0.5f));
-    if (spawnDelay < SPAWN_DELAY_MINIMUM) {
-      spawnDelay = SPAWN_DELAY_MINIMUM;
-    }
+bool resumeSavedGame() {
+  allocStatsAllowFrame();
+  if (!loadWorldFromFile(world, SAVEGAME_FILENAME) || world.gameOver) {
+    return false;
+  }
+  clearRewind();
 
-    // Adiciona objetos gradualmente (até 8 níveis)
-    int targetObjects = std::min(
-        MAX_NUM_OBJECTS, 2 + std::min(4, (currentDifficultyLevel - 1 + 1) / 2));
-    if (objects.size() < static_cast<size_t>(targetObjects)) {
-      objects.push_back(FallingObject());
-    }
+  gameState = STATE_PAUSED;
+  updateWindowTitle();
 
-    // Próximo threshold de dificuldade (progressão exponencial suave)
-    scoreForNextDifficultyIncrease += static_cast<int>(
-        INITIAL_SCORE_FOR_DIFFICULTY *
-        pow(DIFFICULTY_SCALING_FACTOR, currentDifficultyLevel - 1));
+  if (audioManager.isEnabled()) {
+    audioManager.setMusicVolume(16);
+    audioManager.pauseMusic(); // Volta junto com o jogo ao despausar
   }
+  return true;
 }
 
-int getDifficultyLevel() { return currentDifficultyLevel; }
-
-float getDifficultyMultiplier() { return difficultyMultiplier; }
-
-void initPauseMenu() {
-  pauseButtons.clear();
-  pauseButtons.push_back(Button(0.0f, 0.3f, 0.8f, 0.15f, "Continuar"));
-  pauseButtons.push_back(Button(0.0f, 0.1f, 0.8f, 0.15f, "Reiniciar"));
-  pauseButtons.push_back(Button(0.0f, -0.1f, 0.8f, 0.15f, "Tela Inicial"));
-  pauseButtons.push_back(Button(0.0f, -0.3f, 0.8f, 0.15f, "Sair do Jogo"));
-}
+void initPauseMenu() { createPauseButtons(pauseButtons); }
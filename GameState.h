@@ -3,41 +3,23 @@
 
 #include "GameConstants.h"
 #include "GameObjects.h"
+#include "RewindBuffer.h"
+#include "World.h"
 #include <string>
 #include <vector>
 
 // Variáveis globais de estado do jogo
 extern GameState gameState;
 extern std::string currentPlayerName;
-extern std::vector<FallingObject> objects;
+extern World world; // Partida exibida na janela
 extern std::vector<Building> cityscape;
-extern Basket basket;
-extern int score;
-extern int misses;
 extern int windowWidth, windowHeight;
-extern bool key_a_pressed, key_d_pressed;
 
 // Telas e Menus
 extern std::vector<Button> pauseButtons;
 extern Button homeButton;
 extern float mouseGameX, mouseGameY;
 
-// Dificuldade Dinâmica
-extern float currentMinObjectSpeed;
-extern float currentMaxObjectSpeedOffset;
-extern int scoreForNextDifficultyIncrease;
-extern int currentDifficultyLevel;
-extern int spawnDelay;
-extern int spawnTimer;
-extern float difficultyMultiplier;
-
-// Animação de Game Over
-extern std::vector<TrashParticle> trashRain;
-extern float gameOverAnimationTimer;
-extern int displayedScore, finalScoreHolder;
-extern float gameOverBasketAngle;
-extern float gameOverBasketY;
-
 // Animação da Tela Inicial
 extern std::vector<TrashParticle> homeScreenDebris;
 extern float homeScreenAnimationTimer;
@@ -45,17 +27,21 @@ extern float homeScreenAnimationTimer;
 // Ranking
 extern std::vector<PlayerScore> ranking;
 
+// Últimos ticks da partida; segurar Backspace volta no tempo
+extern RewindBuffer rewindBuffer;
+extern bool rewindHeld;
+
+// Pontuação mostrada no título da janela (-1 fora de jogo)
+extern int titleScore;
+
 // Funções principais
+void simulateTick(float dt); // Tela atual; a partida só avança em jogo
 void updateWindowTitle();
-void triggerGameOver();
+void dispatchGameEvents(); // Entrega os eventos do tick aos consumidores
 void resetGame();
 void goToHomeScreen();
+bool resumeSavedGame(); // Volta à partida salva, pausada
 void initPauseMenu();
 void initHomeScreen();
 
-// Funções de dificuldade
-void updateDifficulty();
-int getDifficultyLevel();
-float getDifficultyMultiplier();
-
 #endif // GAME_STATE_H
@@ -0,0 +1,109 @@
+#include "GlStats.h"
+#include "GameConstants.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+const int GL_STATS_SCREENS = STATE_GAMEOVER + 1;
+static const char *const SCREEN_NAMES[GL_STATS_SCREENS] = {
+    "inicio", "jogo", "pausa", "fim de jogo"};
+
+// Soma dos frames de cada tela e o frame mais caro (em chamadas)
+struct ScreenTotals {
+  long frames;
+  GlCallCounts sum;
+  GlCallCounts peak;
+};
+
+static GlCallCounts lastFrame;
+static ScreenTotals screens[GL_STATS_SCREENS];
+static std::string exportFile;
+
+#ifdef GL_INSTRUMENTATION
+GlCallCounts glStatsFrame;
+long glStatsVertexBytes = 0;
+long glStatsColorBytes = 0;
+
+bool glStatsEnabled() { return true; }
+
+static void addCounts(GlCallCounts &total, const GlCallCounts &frame) {
+  total.calls += frame.calls;
+  total.primitives += frame.primitives;
+  total.vertices += frame.vertices;
+  total.colors += frame.colors;
+  total.stateChanges += frame.stateChanges;
+  total.matrixOps += frame.matrixOps;
+  total.textChars += frame.textChars;
+  total.uploadBytes += frame.uploadBytes;
+}
+#else
+bool glStatsEnabled() { return false; }
+#endif
+
+void glStatsEndFrame(int screen) {
+#ifdef GL_INSTRUMENTATION
+  lastFrame = glStatsFrame;
+  memset(&glStatsFrame, 0, sizeof(glStatsFrame));
+  if (screen >= 0 && screen < GL_STATS_SCREENS) {
+    ScreenTotals &t = screens[screen];
+    t.frames++;
+    addCounts(t.sum, lastFrame);
+    if (lastFrame.calls > t.peak.calls) {
+      t.peak = lastFrame;
+    }
+  }
+#else
+  (void)screen;
+#endif
+}
+
+const GlCallCounts &glStatsLastFrame() { return lastFrame; }
+
+void glStatsSetExportFile(const char *filename) { exportFile = filename; }
+
+void glStatsReport() {
+  if (!glStatsEnabled()) {
+    if (!exportFile.empty()) {
+      fprintf(stderr, "--gl-stats exige compilar com make GLSTATS=1\n");
+    }
+    return;
+  }
+
+  FILE *csv = NULL;
+  if (!exportFile.empty()) {
+    csv = fopen(exportFile.c_str(), "w");
+    if (!csv) {
+      fprintf(stderr, "Erro ao criar %s\n", exportFile.c_str());
+    } else {
+      fprintf(csv, "tela,frames,chamadas,primitivas,vertices,cores,estado,"
+                   "matriz,caracteres,bytes,pico_chamadas\n");
+    }
+  }
+
+  printf("Chamadas de GL por frame (media por tela):\n");
+  for (int i = 0; i < GL_STATS_SCREENS; ++i) {
+    const ScreenTotals &t = screens[i];
+    if (t.frames == 0) {
+      continue;
+    }
+    double n = static_cast<double>(t.frames);
+    printf("  %-11s %6ld frames: %7.0f chamadas, %6.0f primitivas, %7.0f "
+           "vertices, %5.0f cores, %4.0f estado, %4.0f matriz, %4.0f "
+           "caracteres, %6.1f KB (pico %ld chamadas)\n",
+           SCREEN_NAMES[i], t.frames, t.sum.calls / n, t.sum.primitives / n,
+           t.sum.vertices / n, t.sum.colors / n, t.sum.stateChanges / n,
+           t.sum.matrixOps / n, t.sum.textChars / n,
+           t.sum.uploadBytes / n / 1024.0, t.peak.calls);
+    if (csv) {
+      fprintf(csv, "%s,%ld,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.0f,%ld\n",
+              SCREEN_NAMES[i], t.frames, t.sum.calls / n,
+              t.sum.primitives / n, t.sum.vertices / n, t.sum.colors / n,
+              t.sum.stateChanges / n, t.sum.matrixOps / n,
+              t.sum.textChars / n, t.sum.uploadBytes / n, t.peak.calls);
+    }
+  }
+  if (csv) {
+    fclose(csv);
+    printf("Contadores de GL exportados para %s\n", exportFile.c_str());
+  }
+}
@@ -0,0 +1,237 @@
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+#include <GL/glut.h>
+
+// Contagem opcional das chamadas de GL do desenho, por frame e por tela.
+// Só existe quando compilado com -DGL_INSTRUMENTATION (make GLSTATS=1):
+// este cabeçalho troca as funções de GL usadas pelo jogo por versões que
+// contam e repassam a chamada. Sem a flag nada é contado e as funções
+// abaixo só devolvem zeros. Deve ser o último include de GL do .cpp.
+struct GlCallCounts {
+  long calls;        // Todas as chamadas contadas
+  long primitives;   // glBegin e glDrawArrays
+  long vertices;     // glVertex* e vértices dos glDrawArrays
+  long colors;       // glColor*
+  long stateChanges; // glEnable/glDisable, largura de linha, arrays, ...
+  long matrixOps;    // Pilha e transformações da matriz
+  long textChars;    // Caracteres de glutStrokeCharacter/glutBitmapCharacter
+  long uploadBytes;  // Vértices e cores enviados ao driver
+};
+
+bool glStatsEnabled();
+
+// Fecha o frame em andamento e soma os contadores na tela indicada
+// (GameState); devolve os do frame fechado
+void glStatsEndFrame(int screen);
+const GlCallCounts &glStatsLastFrame();
+
+// Médias por tela (stdout e, se houver arquivo, CSV) ao sair do jogo
+void glStatsSetExportFile(const char *filename);
+void glStatsReport();
+
+#ifdef GL_INSTRUMENTATION
+
+extern GlCallCounts glStatsFrame; // Frame em andamento
+extern long glStatsVertexBytes;   // Bytes por vértice do array de posições
+extern long glStatsColorBytes;    // e do de cores (0 = desligado)
+
+inline void glStatsBegin(GLenum mode) {
+  glStatsFrame.calls++;
+  glStatsFrame.primitives++;
+  glBegin(mode);
+}
+
+inline void glStatsEnd() {
+  glStatsFrame.calls++;
+  glEnd();
+}
+
+inline void glStatsVertex2f(GLfloat x, GLfloat y) {
+  glStatsFrame.calls++;
+  glStatsFrame.vertices++;
+  glStatsFrame.uploadBytes += 2 * sizeof(GLfloat);
+  glVertex2f(x, y);
+}
+
+inline void glStatsColor3f(GLfloat r, GLfloat g, GLfloat b) {
+  glStatsFrame.calls++;
+  glStatsFrame.colors++;
+  glStatsFrame.uploadBytes += 3 * sizeof(GLfloat);
+  glColor3f(r, g, b);
+}
+
+inline void glStatsColor4f(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+  glStatsFrame.calls++;
+  glStatsFrame.colors++;
+  glStatsFrame.uploadBytes += 4 * sizeof(GLfloat);
+  glColor4f(r, g, b, a);
+}
+
+inline void glStatsColor3fv(const GLfloat *v) {
+  glStatsFrame.calls++;
+  glStatsFrame.colors++;
+  glStatsFrame.uploadBytes += 3 * sizeof(GLfloat);
+  glColor3fv(v);
+}
+
+inline void glStatsColor4fv(const GLfloat *v) {
+  glStatsFrame.calls++;
+  glStatsFrame.colors++;
+  glStatsFrame.uploadBytes += 4 * sizeof(GLfloat);
+  glColor4fv(v);
+}
+
+inline void glStatsEnable(GLenum cap) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glEnable(cap);
+}
+
+inline void glStatsDisable(GLenum cap) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glDisable(cap);
+}
+
+inline void glStatsBlendFunc(GLenum src, GLenum dst) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glBlendFunc(src, dst);
+}
+
+inline void glStatsLineWidth(GLfloat width) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glLineWidth(width);
+}
+
+inline void glStatsEnableClientState(GLenum array) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glEnableClientState(array);
+}
+
+inline void glStatsDisableClientState(GLenum array) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glDisableClientState(array);
+  if (array == GL_VERTEX_ARRAY) {
+    glStatsVertexBytes = 0;
+  } else if (array == GL_COLOR_ARRAY) {
+    glStatsColorBytes = 0;
+  }
+}
+
+// Arrays de vértices: o tamanho de cada vértice entra no glDrawArrays
+inline long glStatsTypeSize(GLenum type) {
+  return type == GL_UNSIGNED_BYTE || type == GL_BYTE ? 1 : 4;
+}
+
+inline void glStatsVertexPointer(GLint size, GLenum type, GLsizei stride,
+                                 const GLvoid *pointer) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glStatsVertexBytes = size * glStatsTypeSize(type);
+  glVertexPointer(size, type, stride, pointer);
+}
+
+inline void glStatsColorPointer(GLint size, GLenum type, GLsizei stride,
+                                const GLvoid *pointer) {
+  glStatsFrame.calls++;
+  glStatsFrame.stateChanges++;
+  glStatsColorBytes = size * glStatsTypeSize(type);
+  glColorPointer(size, type, stride, pointer);
+}
+
+inline void glStatsDrawArrays(GLenum mode, GLint first, GLsizei count) {
+  glStatsFrame.calls++;
+  glStatsFrame.primitives++;
+  glStatsFrame.vertices += count;
+  glStatsFrame.uploadBytes += count * (glStatsVertexBytes + glStatsColorBytes);
+  glDrawArrays(mode, first, count);
+}
+
+inline void glStatsPushMatrix() {
+  glStatsFrame.calls++;
+  glStatsFrame.matrixOps++;
+  glPushMatrix();
+}
+
+inline void glStatsPopMatrix() {
+  glStatsFrame.calls++;
+  glStatsFrame.matrixOps++;
+  glPopMatrix();
+}
+
+inline void glStatsTranslatef(GLfloat x, GLfloat y, GLfloat z) {
+  glStatsFrame.calls++;
+  glStatsFrame.matrixOps++;
+  glTranslatef(x, y, z);
+}
+
+inline void glStatsRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z) {
+  glStatsFrame.calls++;
+  glStatsFrame.matrixOps++;
+  glRotatef(angle, x, y, z);
+}
+
+inline void glStatsScalef(GLfloat x, GLfloat y, GLfloat z) {
+  glStatsFrame.calls++;
+  glStatsFrame.matrixOps++;
+  glScalef(x, y, z);
+}
+
+inline void glStatsRasterPos2f(GLfloat x, GLfloat y) {
+  glStatsFrame.calls++;
+  glRasterPos2f(x, y);
+}
+
+inline void glStatsClear(GLbitfield mask) {
+  glStatsFrame.calls++;
+  glClear(mask);
+}
+
+// O GLUT desenha cada caractere com as suas próprias chamadas, que não
+// passam por aqui: conta-se o caractere
+inline void glStatsStrokeCharacter(void *font, int character) {
+  glStatsFrame.calls++;
+  glStatsFrame.textChars++;
+  glutStrokeCharacter(font, character);
+}
+
+inline void glStatsBitmapCharacter(void *font, int character) {
+  glStatsFrame.calls++;
+  glStatsFrame.textChars++;
+  glutBitmapCharacter(font, character);
+}
+
+#define glBegin glStatsBegin
+#define glEnd glStatsEnd
+#define glVertex2f glStatsVertex2f
+#define glColor3f glStatsColor3f
+#define glColor4f glStatsColor4f
+#define glColor3fv glStatsColor3fv
+#define glColor4fv glStatsColor4fv
+#define glEnable glStatsEnable
+#define glDisable glStatsDisable
+#define glBlendFunc glStatsBlendFunc
+#define glLineWidth glStatsLineWidth
+#define glEnableClientState glStatsEnableClientState
+#define glDisableClientState glStatsDisableClientState
+#define glVertexPointer glStatsVertexPointer
+#define glColorPointer glStatsColorPointer
+#define glDrawArrays glStatsDrawArrays
+#define glPushMatrix glStatsPushMatrix
+#define glPopMatrix glStatsPopMatrix
+#define glTranslatef glStatsTranslatef
+#define glRotatef glStatsRotatef
+#define glScalef glStatsScalef
+#define glRasterPos2f glStatsRasterPos2f
+#define glClear glStatsClear
+#define glutStrokeCharacter glStatsStrokeCharacter
+#define glutBitmapCharacter glStatsBitmapCharacter
+
+#endif // GL_INSTRUMENTATION
+
+#endif // GL_STATS_H
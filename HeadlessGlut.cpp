@@ -0,0 +1,133 @@
+#include "HeadlessGlut.h"
+#include <EGL/egl.h>
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+
+// Mesmo layout das fontes em fg_internal.h do freeglut 3. Os dados ficam
+// exportados na biblioteca; só as funções que os desenham exigem glutInit.
+struct StrokeVertex {
+  GLfloat x, y;
+};
+struct StrokeStrip {
+  int number;
+  const StrokeVertex *vertices;
+};
+struct StrokeChar {
+  GLfloat right;
+  int number;
+  const StrokeStrip *strips;
+};
+struct StrokeFont {
+  char *name;
+  int quantity;
+  GLfloat height;
+  const StrokeChar **characters;
+};
+struct BitmapFont {
+  char *name;
+  int quantity;
+  int height;
+  const GLubyte **characters; // Largura e depois as linhas do glyph
+  float xorig, yorig;
+};
+
+extern "C" {
+extern StrokeFont fgStrokeRoman;
+extern StrokeFont fgStrokeMonoRoman;
+extern BitmapFont fgFontHelvetica10;
+extern BitmapFont fgFontHelvetica12;
+extern BitmapFont fgFontHelvetica18;
+extern BitmapFont fgFontTimesRoman10;
+extern BitmapFont fgFontTimesRoman24;
+extern BitmapFont fgFontFixed8x13;
+extern BitmapFont fgFontFixed9x15;
+}
+
+static int elapsedTime = 0;
+
+void setHeadlessTime(int elapsedMs) { elapsedTime = elapsedMs; }
+
+int glutGet(GLenum query) {
+  if (query == GLUT_ELAPSED_TIME) {
+    return elapsedTime;
+  }
+  return 0;
+}
+
+// Funções de extensão do contexto EGL (pixel buffers da FrameCapture)
+GLUTproc glutGetProcAddress(const char *procName) {
+  return reinterpret_cast<GLUTproc>(eglGetProcAddress(procName));
+}
+
+static const StrokeChar *strokeChar(void *font, int character) {
+  const StrokeFont *f = NULL;
+  if (font == GLUT_STROKE_ROMAN) {
+    f = &fgStrokeRoman;
+  } else if (font == GLUT_STROKE_MONO_ROMAN) {
+    f = &fgStrokeMonoRoman;
+  }
+  if (!f || character < 0 || character >= f->quantity) {
+    return NULL;
+  }
+  return f->characters[character];
+}
+
+static const BitmapFont *bitmapFont(void *font) {
+  if (font == GLUT_BITMAP_HELVETICA_10) {
+    return &fgFontHelvetica10;
+  } else if (font == GLUT_BITMAP_HELVETICA_12) {
+    return &fgFontHelvetica12;
+  } else if (font == GLUT_BITMAP_HELVETICA_18) {
+    return &fgFontHelvetica18;
+  } else if (font == GLUT_BITMAP_TIMES_ROMAN_10) {
+    return &fgFontTimesRoman10;
+  } else if (font == GLUT_BITMAP_TIMES_ROMAN_24) {
+    return &fgFontTimesRoman24;
+  } else if (font == GLUT_BITMAP_8_BY_13) {
+    return &fgFontFixed8x13;
+  } else if (font == GLUT_BITMAP_9_BY_15) {
+    return &fgFontFixed9x15;
+  }
+  return NULL;
+}
+
+// Como no freeglut: cada traço é uma GL_LINE_STRIP e o caractere avança a
+// matriz pela sua largura
+void glutStrokeCharacter(void *font, int character) {
+  const StrokeChar *c = strokeChar(font, character);
+  if (!c) {
+    return;
+  }
+  const StrokeStrip *strip = c->strips;
+  for (int i = 0; i < c->number; ++i, ++strip) {
+    glBegin(GL_LINE_STRIP);
+    for (int j = 0; j < strip->number; ++j) {
+      glVertex2f(strip->vertices[j].x, strip->vertices[j].y);
+    }
+    glEnd();
+  }
+  glTranslatef(c->right, 0.0f, 0.0f);
+}
+
+int glutStrokeWidth(void *font, int character) {
+  const StrokeChar *c = strokeChar(font, character);
+  return c ? static_cast<int>(c->right + 0.5f) : 0;
+}
+
+void glutBitmapCharacter(void *font, int character) {
+  const BitmapFont *f = bitmapFont(font);
+  if (!f || character < 1 || character >= f->quantity) {
+    return;
+  }
+  const GLubyte *face = f->characters[character];
+  glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+  glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_FALSE);
+  glPixelStorei(GL_UNPACK_LSB_FIRST, GL_FALSE);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glBitmap(face[0], f->height, f->xorig, f->yorig,
+           static_cast<float>(face[0]), 0.0f, face + 1);
+  glPopClientAttrib();
+}
@@ -0,0 +1,15 @@
+#ifndef HEADLESS_GLUT_H
+#define HEADLESS_GLUT_H
+
+// O freeglut só desenha texto e responde glutGet depois de glutInit, que
+// exige um servidor gráfico. Ligado a um programa sem janela (offscreen),
+// HeadlessGlut.cpp substitui as funções do GLUT usadas no desenho:
+// glutGet, glutStrokeCharacter, glutStrokeWidth, glutBitmapCharacter e
+// glutGetProcAddress (pelo EGL). O texto sai com as mesmas fontes do
+// freeglut, lidas da própria biblioteca.
+
+// Valor de glutGet(GLUT_ELAPSED_TIME); o relógio só anda quando pedido,
+// então o pisca das janelas e do cursor é reproduzível
+void setHeadlessTime(int elapsedMs);
+
+#endif // HEADLESS_GLUT_H
@@ -1,9 +1,10 @@
 #include "InputHandler.h"
 #include "AudioManager.h"
 #include "GameConstants.h"
+#include "GameLoop.h"
 #include "GameState.h"
+#include "SimulationThread.h"
 #include <GL/glut.h>
-#include <cstdlib>
 
 void convertMouseToGameCoords(int mouseX, int mouseY, float &gameX,
                               float &gameY) {
@@ -26,9 +27,7 @@ void convertMouseToGameCoords(int mouseX, int mouseY, float &gameX,
   gameY = worldTop - (mouseY / (float)windowHeight) * (worldTop - worldBottom);
 }
 
-void keyboard(unsigned char key, int x, int y) {
-  (void)x; 
-  (void)y; 
+static void applyKey(unsigned char key) {
   switch (gameState) {
   case STATE_HOME:
     if (key == 8) { // Backspace
@@ -42,7 +41,7 @@ void keyboard(unsigned char key, int x, int y) {
     } else if (key == 13) { // Enter
       resetGame();
     } else if (key == 27) { // ESC
-      exit(0);
+      requestQuit();
     }
     break;
   case STATE_PLAYING:
@@ -53,9 +52,11 @@ void keyboard(unsigned char key, int x, int y) {
         audioManager.pauseMusic();
       }
     } else if (key == 27) {
-      exit(0);
+      requestQuit();
     } else if (key >= '1' && key <= '5') {
-      basket.wasteType = static_cast<WASTE_TYPE>(key - '1');
+      world.basket.wasteType = static_cast<WASTE_TYPE>(key - '1');
+    } else if (key == 8) { // Backspace: volta no tempo enquanto segurado
+      rewindHeld = true;
     }
     break;
   case STATE_PAUSED:
@@ -66,7 +67,7 @@ void keyboard(unsigned char key, int x, int y) {
         audioManager.resumeMusic();
       }
     } else if (key == 27) {
-      exit(0);
+      requestQuit();
     }
     break;
   case STATE_GAMEOVER:
@@ -74,45 +75,46 @@ void keyboard(unsigned char key, int x, int y) {
       resetGame();
     } else if (key == 'm' || key == 'M') {
       goToHomeScreen();
+    } else if (key == 8) {
+      rewindHeld = true;
     } else if (key == 27) {
-      exit(0);
+      requestQuit();
     }
     break;
   }
 }
 
-void specialKeyboard(int key, int x, int y) {
-  (void)x;
-  (void)y;
+static void applyKeyUp(unsigned char key) {
+  if (key == 8) {
+    rewindHeld = false;
+  }
+}
+
+static void applySpecialDown(int key) {
   if (gameState != STATE_PLAYING) {
     return;
   }
 
   if (key == GLUT_KEY_LEFT) {
-    key_a_pressed = true;
+    world.moveLeft = true;
   }
   if (key == GLUT_KEY_RIGHT) {
-    key_d_pressed = true;
+    world.moveRight = true;
   }
 }
 
-void specialKeyboardUp(int key, int x, int y) {
-  (void)x;
-  (void)y;
+static void applySpecialUp(int key) {
   if (key == GLUT_KEY_LEFT) {
-    key_a_pressed = false;
+    world.moveLeft = false;
   }
   if (key == GLUT_KEY_RIGHT) {
-    key_d_pressed = false;
+    world.moveRight = false;
   }
 }
 
-void mouseClick(int button, int state, int x, int y) {
-  if (button != GLUT_LEFT_BUTTON || state != GLUT_DOWN) {
-    return;
-  }
-
-  convertMouseToGameCoords(x, y, mouseGameX, mouseGameY);
+static void applyMouseClick(float x, float y) {
+  mouseGameX = x;
+  mouseGameY = y;
 
   if (gameState == STATE_PAUSED) {
     if (pauseButtons[0].isInside(mouseGameX, mouseGameY)) {
@@ -138,7 +140,7 @@ void mouseClick(int button, int state, int x, int y) {
       if (audioManager.isEnabled()) {
         audioManager.playSound("button_click");
       }
-      exit(0);
+      requestQuit();
     }
   } else if (gameState == STATE_HOME) {
     if (homeButton.isInside(mouseGameX, mouseGameY)) {
@@ -150,16 +152,15 @@ void mouseClick(int button, int state, int x, int y) {
   }
 }
 
-void mousePassiveMotion(int x, int y) {
-  convertMouseToGameCoords(x, y, mouseGameX, mouseGameY);
-  bool needsRedraw = false;
+static void applyMouseMove(float x, float y) {
+  mouseGameX = x;
+  mouseGameY = y;
 
   if (gameState == STATE_PAUSED) {
     for (size_t i = 0; i < pauseButtons.size(); ++i) {
       bool isInside = pauseButtons[i].isInside(mouseGameX, mouseGameY);
       if (pauseButtons[i].isHovered != isInside) {
         pauseButtons[i].isHovered = isInside;
-        needsRedraw = true;
       }
     }
 
@@ -167,11 +168,90 @@ void mousePassiveMotion(int x, int y) {
     bool isInside = homeButton.isInside(mouseGameX, mouseGameY);
     if (homeButton.isHovered != isInside) {
       homeButton.isHovered = isInside;
-      needsRedraw = true;
     }
   }
+}
 
-  if (needsRedraw) {
-    glutPostRedisplay();
+void applyInputCommand(const InputCommand &command) {
+  switch (command.type) {
+  case INPUT_KEY:
+    applyKey(static_cast<unsigned char>(command.key));
+    break;
+  case INPUT_KEY_UP:
+    applyKeyUp(static_cast<unsigned char>(command.key));
+    break;
+  case INPUT_SPECIAL_DOWN:
+    applySpecialDown(command.key);
+    break;
+  case INPUT_SPECIAL_UP:
+    applySpecialUp(command.key);
+    break;
+  case INPUT_MOUSE_CLICK:
+    applyMouseClick(command.x, command.y);
+    break;
+  case INPUT_MOUSE_MOVE:
+    applyMouseMove(command.x, command.y);
+    break;
   }
 }
+
+// Callbacks do GLUT: só traduzem o evento e o enfileiram para a simulação
+static void sendInput(InputCommandType type, int key, float x, float y) {
+  InputCommand command;
+  command.type = type;
+  command.key = key;
+  command.x = x;
+  command.y = y;
+  pushInputCommand(command); // Fila cheia: o evento é descartado
+}
+
+void keyboard(unsigned char key, int x, int y) {
+  (void)x;
+  (void)y;
+  sendInput(INPUT_KEY, key, 0.0f, 0.0f);
+}
+
+void keyboardUp(unsigned char key, int x, int y) {
+  (void)x;
+  (void)y;
+  sendInput(INPUT_KEY_UP, key, 0.0f, 0.0f);
+}
+
+void specialKeyboard(int key, int x, int y) {
+  (void)x;
+  (void)y;
+  if (key == GLUT_KEY_F3) { // Overlay de desempenho: só muda o desenho
+    toggleProfilerOverlay();
+    return;
+  }
+  if (key == GLUT_KEY_F11) { // Gravação e captura: só leem o framebuffer
+    toggleRecording();
+    return;
+  }
+  if (key == GLUT_KEY_F12) {
+    requestScreenshot();
+    return;
+  }
+  sendInput(INPUT_SPECIAL_DOWN, key, 0.0f, 0.0f);
+}
+
+void specialKeyboardUp(int key, int x, int y) {
+  (void)x;
+  (void)y;
+  sendInput(INPUT_SPECIAL_UP, key, 0.0f, 0.0f);
+}
+
+void mouseClick(int button, int state, int x, int y) {
+  if (button != GLUT_LEFT_BUTTON || state != GLUT_DOWN) {
+    return;
+  }
+  float gameX, gameY;
+  convertMouseToGameCoords(x, y, gameX, gameY);
+  sendInput(INPUT_MOUSE_CLICK, 0, gameX, gameY);
+}
+
+void mousePassiveMotion(int x, int y) {
+  float gameX, gameY;
+  convertMouseToGameCoords(x, y, gameX, gameY);
+  sendInput(INPUT_MOUSE_MOVE, 0, gameX, gameY);
+}
@@ -1,13 +1,34 @@
 #ifndef INPUT_HANDLER_H
 #define INPUT_HANDLER_H
 
-// Funções de entrada
+// Entrada vinda da thread do GLUT, aplicada pela thread de simulação no
+// início do próximo tick
+enum InputCommandType {
+  INPUT_KEY,
+  INPUT_KEY_UP,
+  INPUT_SPECIAL_DOWN,
+  INPUT_SPECIAL_UP,
+  INPUT_MOUSE_CLICK,
+  INPUT_MOUSE_MOVE
+};
+
+struct InputCommand {
+  InputCommandType type;
+  int key;    // Tecla (INPUT_KEY e teclas especiais)
+  float x, y; // Posição do mouse em coordenadas do jogo
+};
+
+// Funções de entrada (callbacks do GLUT)
 void convertMouseToGameCoords(int mouseX, int mouseY, float &gameX,
                               float &gameY);
 void keyboard(unsigned char key, int x, int y);
+void keyboardUp(unsigned char key, int x, int y);
 void specialKeyboard(int key, int x, int y);
 void specialKeyboardUp(int key, int x, int y);
 void mouseClick(int button, int state, int x, int y);
 void mousePassiveMotion(int x, int y);
 
+// Thread de simulação
+void applyInputCommand(const InputCommand &command);
+
 #endif // INPUT_HANDLER_H
@@ -0,0 +1,59 @@
+#include "MemoryStats.h"
+#include <atomic>
+#include <cstdio>
+
+static const char *const CATEGORY_NAMES[MEMORY_CATEGORY_COUNT] = {
+    "particulas", "objetos", "cenario", "ranking",
+    "efeitos",    "musica",  "texto",   "rewind"};
+
+static std::atomic<size_t> live[MEMORY_CATEGORY_COUNT];
+static std::atomic<size_t> peak[MEMORY_CATEGORY_COUNT];
+static std::atomic<size_t> totalLive;
+static std::atomic<size_t> totalPeak;
+
+static void raisePeak(std::atomic<size_t> &peakBytes, size_t value) {
+  size_t seen = peakBytes.load();
+  while (value > seen && !peakBytes.compare_exchange_weak(seen, value)) {
+  }
+}
+
+void MemoryAccount::track(size_t newBytes) {
+  if (newBytes > bytes) {
+    size_t grown = newBytes - bytes;
+    raisePeak(peak[category], live[category] += grown);
+    raisePeak(totalPeak, totalLive += grown);
+  } else if (newBytes < bytes) {
+    live[category] -= bytes - newBytes;
+    totalLive -= bytes - newBytes;
+  }
+  bytes = newBytes;
+}
+
+size_t stringHeapBytes(const std::string &s) {
+  // Strings curtas ficam dentro do objeto (SSO): capacidade dele
+  static const size_t inlineCapacity = std::string().capacity();
+  return s.capacity() > inlineCapacity ? s.capacity() + 1 : 0;
+}
+
+const char *memoryCategoryName(MemoryCategory category) {
+  return CATEGORY_NAMES[category];
+}
+
+size_t memoryStatsLive(MemoryCategory category) { return live[category]; }
+
+size_t memoryStatsPeak(MemoryCategory category) { return peak[category]; }
+
+size_t memoryStatsTotalLive() { return totalLive; }
+
+size_t memoryStatsTotalPeak() { return totalPeak; }
+
+void memoryStatsReport() {
+  printf("\n=== Memoria por subsistema (KB) ===\n");
+  printf("%-12s %10s %10s\n", "", "vivo", "pico");
+  for (int c = 0; c < MEMORY_CATEGORY_COUNT; ++c) {
+    printf("%-12s %10.1f %10.1f\n", CATEGORY_NAMES[c], live[c] / 1024.0,
+           peak[c] / 1024.0);
+  }
+  printf("%-12s %10.1f %10.1f\n", "total", totalLive / 1024.0,
+         totalPeak / 1024.0);
+}
@@ -0,0 +1,58 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Memória por subsistema: bytes vivos e o pico de cada categoria, para
+// saber quanto custa uma pilha grande de game over ou um ranking de uma
+// sessão longa. Não intercepta o heap: cada dono de memória informa o
+// total que mantém agora por uma MemoryAccount, e as contas da mesma
+// categoria se somam. Os contadores são atômicos (simulação, desenho e
+// carregamento de áudio informam de threads diferentes).
+enum MemoryCategory {
+  MEMORY_PARTICLES,    // Chuva de lixo e detritos da tela inicial
+  MEMORY_OBJECTS,      // Objetos caindo e cestas extras
+  MEMORY_SCENERY,      // Prédios do cenário
+  MEMORY_RANKING,      // Ranking carregado e suas cópias
+  MEMORY_AUDIO_CHUNKS, // Efeitos decodificados
+  MEMORY_MUSIC,        // Músicas em PCM (cache) e dados dos streams
+  MEMORY_TEXT,         // Textos e temporários do frame (FrameArena)
+  MEMORY_REWIND,       // Histórico do rewind
+  MEMORY_CATEGORY_COUNT
+};
+
+// Memória de um dono numa categoria. track() recebe o total atual, não a
+// diferença; o destrutor devolve o que ainda estava informado
+class MemoryAccount {
+public:
+  explicit MemoryAccount(MemoryCategory category)
+      : category(category), bytes(0) {}
+  ~MemoryAccount() { track(0); }
+
+  void track(size_t bytes);
+
+private:
+  MemoryAccount(const MemoryAccount &);
+  MemoryAccount &operator=(const MemoryAccount &);
+
+  MemoryCategory category;
+  size_t bytes;
+};
+
+// Reservado por um vetor (capacidade, não tamanho)
+template <typename T> size_t vectorBytes(const std::vector<T> &v) {
+  return v.capacity() * sizeof(T);
+}
+// Só o que a string guarda fora do próprio objeto
+size_t stringHeapBytes(const std::string &s);
+
+const char *memoryCategoryName(MemoryCategory category);
+size_t memoryStatsLive(MemoryCategory category);
+size_t memoryStatsPeak(MemoryCategory category);
+size_t memoryStatsTotalLive();
+size_t memoryStatsTotalPeak(); // Pico da soma, não a soma dos picos
+void memoryStatsReport();      // Tabela no stdout (atexit)
+
+#endif // MEMORY_STATS_H
@@ -0,0 +1,411 @@
+// Renderizador sem janela: desenha as telas do jogo com o mesmo drawFrame()
+// de display() num pbuffer EGL, sem servidor gráfico nem GPU (o llvmpipe
+// do Mesa serve). Grava os frames em PPM, mede frames/s por tela e compara
+// com imagens de referência, para provar que uma otimização de desenho
+// não mudou a saída.
+//
+// Uso: ./offscreen [opções] [inicio|jogo|pausa|fim ...] (padrão: todas)
+//   --size LxA       tamanho do frame (600x800)
+//   --frames N       frames medidos por tela (padrão 0: só a imagem)
+//   --objects N      modo stress com N objetos na tela de jogo
+//   --particles N    partículas da chuva do game over (1200)
+//   --quality N      nível de qualidade 0..3 (padrão: o mais alto)
+//   --out DIR        grava DIR/<tela>.ppm
+//   --golden DIR     compara com DIR/<tela>.ppm e falha se diferir
+//   --tolerance PCT  pixels diferentes aceitos na comparação (0.1)
+//   --record FILE    grava os frames medidos em FILE (Y4M) pela FrameCapture
+//   --capture-sync   na gravação, lê o frame sem pixel buffer objects
+//   --shaders        céu, chão e janelas pelo caminho em GLSL (SceneryShader)
+//
+// Compilado com make ALLOCSTATS=1, os frames medidos também não podem
+// alocar memória: a tela que alocar falha.
+//
+// Sem servidor gráfico, rode com EGL_PLATFORM=surfaceless.
+#include "AllocStats.h"
+#include "AutoplayBot.h"
+#include "FrameArena.h"
+#include "FrameCapture.h"
+#include "HeadlessGlut.h"
+#include "QualityGovernor.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
+#include "Scenery.h"
+#include "SceneryShader.h"
+#include "Screens.h"
+#include "Simulation.h"
+#include <EGL/egl.h>
+#include <GL/gl.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+const int SCREEN_COUNT = STATE_GAMEOVER + 1;
+static const char *const SCREEN_NAMES[SCREEN_COUNT] = {"inicio", "jogo",
+                                                       "pausa", "fim"};
+
+const int FRAME_TIME_MS = 1000 / 60; // Relógio do GLUT avança por frame
+const int IMAGE_TIME_MS = 1000;      // Instante das imagens de referência
+const int PLAY_SECONDS = 20;         // Jogo antes da imagem de jogo/pausa
+const int MAX_RAIN_SECONDS = 600;    // Limite para encher a chuva
+const int PIXEL_TOLERANCE = 8;       // Diferença por canal ignorada
+
+struct Options {
+  int width, height;
+  int frames;
+  int objects;
+  int particles;
+  int quality;
+  std::string outDir, goldenDir, recordFile;
+  double tolerancePercent;
+  bool captureSync;
+  bool shaders;
+  bool screens[SCREEN_COUNT];
+};
+
+static bool parseOptions(int argc, char **argv, Options &o) {
+  o.width = 600;
+  o.height = 800;
+  o.frames = 0;
+  o.objects = 0;
+  o.particles = TRASH_RAIN_MAX_PARTICLES;
+  o.quality = QUALITY_LEVEL_COUNT - 1;
+  o.tolerancePercent = 0.1;
+  o.captureSync = false;
+  o.shaders = false;
+  bool anyScreen = false;
+  memset(o.screens, 0, sizeof(o.screens));
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--size" && hasValue) {
+      if (sscanf(argv[++i], "%dx%d", &o.width, &o.height) != 2) {
+        return false;
+      }
+    } else if (arg == "--frames" && hasValue) {
+      o.frames = atoi(argv[++i]);
+    } else if (arg == "--objects" && hasValue) {
+      o.objects = atoi(argv[++i]);
+    } else if (arg == "--particles" && hasValue) {
+      o.particles = atoi(argv[++i]);
+    } else if (arg == "--quality" && hasValue) {
+      o.quality = atoi(argv[++i]);
+    } else if (arg == "--out" && hasValue) {
+      o.outDir = argv[++i];
+    } else if (arg == "--golden" && hasValue) {
+      o.goldenDir = argv[++i];
+    } else if (arg == "--tolerance" && hasValue) {
+      o.tolerancePercent = atof(argv[++i]);
+    } else if (arg == "--record" && hasValue) {
+      o.recordFile = argv[++i];
+    } else if (arg == "--capture-sync") {
+      o.captureSync = true;
+    } else if (arg == "--shaders") {
+      o.shaders = true;
+    } else {
+      int screen = -1;
+      for (int s = 0; s < SCREEN_COUNT; ++s) {
+        if (arg == SCREEN_NAMES[s]) {
+          screen = s;
+        }
+      }
+      if (screen < 0) {
+        return false;
+      }
+      o.screens[screen] = true;
+      anyScreen = true;
+    }
+  }
+  if (!anyScreen) {
+    for (int s = 0; s < SCREEN_COUNT; ++s) {
+      o.screens[s] = true;
+    }
+  }
+  return o.width > 0 && o.height > 0 && o.frames >= 0 && o.objects >= 0 &&
+         o.particles >= 0 && o.quality >= 0 &&
+         o.quality < QUALITY_LEVEL_COUNT;
+}
+
+// Pbuffer com contexto OpenGL de compatibilidade (o jogo usa o pipeline
+// fixo)
+static bool createContext(int width, int height) {
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+    fprintf(stderr, "EGL indisponivel (sem servidor grafico, use "
+                    "EGL_PLATFORM=surfaceless)\n");
+    return false;
+  }
+  const EGLint configAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                                  EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8,
+                                  EGL_BLUE_SIZE, 8, EGL_RENDERABLE_TYPE,
+                                  EGL_OPENGL_BIT, EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) ||
+      configCount == 0) {
+    fprintf(stderr, "Nenhuma configuracao EGL com OpenGL e pbuffer\n");
+    return false;
+  }
+  const EGLint surfaceAttribs[] = {EGL_WIDTH, width, EGL_HEIGHT, height,
+                                   EGL_NONE};
+  EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+  eglBindAPI(EGL_OPENGL_API);
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+  if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+      !eglMakeCurrent(display, surface, surface, context)) {
+    fprintf(stderr, "Erro ao criar o contexto EGL\n");
+    return false;
+  }
+  printf("Renderizador: %s\n", glGetString(GL_RENDERER));
+  return true;
+}
+
+// Estado do GL de main() e a projeção de reshape()
+static void setupView(int width, int height, const QualitySettings &q) {
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+  if (q.lineSmooth) {
+    glEnable(GL_LINE_SMOOTH);
+  }
+
+  glViewport(0, 0, width, height);
+  glMatrixMode(GL_PROJECTION);
+  glLoadIdentity();
+  float aspect = (float)width / (float)height;
+  if (width <= height) {
+    glOrtho(-1.0f, 1.0f, -1.0f / aspect, 1.0f / aspect, -1.0f, 1.0f);
+  } else {
+    glOrtho(-1.0f * aspect, 1.0f * aspect, -1.0f, 1.0f, -1.0f, 1.0f);
+  }
+  glMatrixMode(GL_MODELVIEW);
+  glLoadIdentity();
+}
+
+// Snapshot da tela pedida, montado sem a thread de simulação: as partidas
+// são jogadas pelo AutoplayBot com seed fixa, então a imagem se repete
+static RenderSnapshot buildSnapshot(int screen, const Options &o) {
+  RenderSnapshot s;
+  s.gameState = static_cast<GameState>(screen);
+  s.currentPlayerName = "Jogador";
+  s.homeButton = Button(0.0f, -0.1f, 0.8f, 0.15f, "Iniciar");
+  createPauseButtons(s.pauseButtons);
+  srand(1);
+  createHomeScreenDebris(s.homeScreenDebris);
+  s.homeScreenAnimationTimer = HOMESCREEN_ANIMATION_DURATION;
+  const char *names[] = {"Ana", "Bruno", "Carla", "Davi", "Elisa"};
+  for (int i = 0; i < 5; ++i) {
+    PlayerScore entry;
+    entry.name = names[i];
+    entry.score = 500 - 80 * i;
+    s.ranking.push_back(entry);
+  }
+  if (screen == STATE_HOME) {
+    return s;
+  }
+
+  const float dt = SIMULATION_TICK_MS / 1000.0f;
+  World world(1);
+  world.rain.maxParticles = o.particles;
+  if (screen != STATE_GAMEOVER) {
+    world.stress.objectCount = o.objects;
+    world.stress.basketCount = o.objects > 0 ? 4 : 0;
+  }
+  world.reset();
+
+  if (screen == STATE_GAMEOVER) {
+    // Sem jogador os erros acabam a partida; depois a chuva enche
+    int ticks = 0;
+    const int maxTicks = MAX_RAIN_SECONDS * 1000 / SIMULATION_TICK_MS;
+    while ((!world.gameOver ||
+            world.trashRain.size() + world.settledRain.size() <
+                static_cast<size_t>(o.particles)) &&
+           ticks++ < maxTicks) {
+      simulateWorld(world, dt);
+      world.events.clear();
+    }
+  } else {
+    AutoplayBot bot(10, 0.05f, 1);
+    int ticks = PLAY_SECONDS * 1000 / SIMULATION_TICK_MS;
+    for (int tick = 0; tick < ticks && !world.gameOver; ++tick) {
+      bot.control(world);
+      simulateWorld(world, dt);
+      world.events.clear();
+    }
+  }
+  s.copyWorld(world);
+  s.titleScore = screen == STATE_PLAYING ? world.score : -1;
+  return s;
+}
+
+static void readFrame(int width, int height, std::vector<unsigned char> &rgb) {
+  rgb.resize(static_cast<size_t>(width) * height * 3);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, &rgb[0]);
+}
+
+// PPM binário, de cima para baixo (o GL lê de baixo para cima)
+static bool writePpm(const std::string &path, int width, int height,
+                     const std::vector<unsigned char> &rgb) {
+  FILE *f = fopen(path.c_str(), "wb");
+  if (!f) {
+    fprintf(stderr, "Erro ao criar %s\n", path.c_str());
+    return false;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", width, height);
+  for (int y = height - 1; y >= 0; --y) {
+    fwrite(&rgb[static_cast<size_t>(y) * width * 3], 1, width * 3, f);
+  }
+  fclose(f);
+  return true;
+}
+
+static bool readPpm(const std::string &path, int &width, int &height,
+                    std::vector<unsigned char> &rgb) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    return false;
+  }
+  int maxValue = 0;
+  bool ok = fscanf(f, "P6 %d %d %d", &width, &height, &maxValue) == 3 &&
+            maxValue == 255 && width > 0 && height > 0 && fgetc(f) != EOF;
+  if (ok) {
+    std::vector<unsigned char> rows(static_cast<size_t>(width) * height * 3);
+    ok = fread(&rows[0], 1, rows.size(), f) == rows.size();
+    // Volta para a ordem do glReadPixels
+    rgb.resize(rows.size());
+    for (int y = 0; ok && y < height; ++y) {
+      memcpy(&rgb[static_cast<size_t>(height - 1 - y) * width * 3],
+             &rows[static_cast<size_t>(y) * width * 3], width * 3);
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+// Pixels com algum canal além de PIXEL_TOLERANCE da referência
+static long countDifferentPixels(const std::vector<unsigned char> &a,
+                                 const std::vector<unsigned char> &b) {
+  long different = 0;
+  for (size_t i = 0; i + 2 < a.size(); i += 3) {
+    for (int c = 0; c < 3; ++c) {
+      if (abs(a[i + c] - b[i + c]) > PIXEL_TOLERANCE) {
+        different++;
+        break;
+      }
+    }
+  }
+  return different;
+}
+
+int main(int argc, char **argv) {
+  Options o;
+  if (!parseOptions(argc, argv, o)) {
+    fprintf(stderr,
+            "Uso: %s [--size LxA] [--frames N] [--objects N] [--particles N] "
+            "[--quality N] [--out DIR] [--golden DIR] [--tolerance PCT] "
+            "[--record FILE] [--capture-sync] [--shaders] "
+            "[inicio|jogo|pausa|fim ...]\n",
+            argv[0]);
+    return 1;
+  }
+  if (!createContext(o.width, o.height)) {
+    return 1;
+  }
+  if (o.shaders && !initSceneryShader()) {
+    return 1;
+  }
+  const QualitySettings &quality = QUALITY_LEVELS[o.quality];
+  setupView(o.width, o.height, quality);
+
+  std::vector<Building> cityscape;
+  initUrbanScenery(cityscape);
+  RenderQueue queue;
+  std::vector<unsigned char> frame, golden;
+  int failures = 0;
+  FrameCapture capture;
+  if (!o.recordFile.empty()) {
+    capture.setSynchronous(o.captureSync);
+    capture.startRecording(o.recordFile);
+  }
+
+  for (int screen = 0; screen < SCREEN_COUNT; ++screen) {
+    if (!o.screens[screen]) {
+      continue;
+    }
+    const char *name = SCREEN_NAMES[screen];
+    RenderSnapshot s = buildSnapshot(screen, o);
+
+    // Imagem num instante fixo do relógio
+    setHeadlessTime(IMAGE_TIME_MS);
+    drawFrame(queue, s, cityscape, o.width, o.height, quality);
+    glFinish();
+    readFrame(o.width, o.height, frame);
+
+    printf("%-6s %6zu objetos, %5zu na chuva, %6d primitivas", name,
+           screen == STATE_GAMEOVER ? 0 : s.objects.size(),
+           s.trashRain.size() + s.settledRain.size(),
+           queue.frameStats().primitives);
+
+    if (o.frames > 0) {
+      std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      long allocatingFrames = 0;
+      for (int i = 0; i < o.frames; ++i) {
+        setHeadlessTime(IMAGE_TIME_MS + i * FRAME_TIME_MS);
+        // O frame da imagem já aqueceu a fila; a gravação aquece nos
+        // primeiros frames do anel
+        frameArena().reset();
+        allocStatsBeginFrame(i > CAPTURE_PBO_COUNT);
+        drawFrame(queue, s, cityscape, o.width, o.height, quality);
+        capture.captureFrame(o.width, o.height);
+        if (allocStatsEndFrame(name) > 0 && i > CAPTURE_PBO_COUNT) {
+          allocatingFrames++;
+        }
+        glFinish(); // Conta o trabalho do rasterizador, não só o envio
+      }
+      double ms = std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count() /
+                  o.frames;
+      printf(" | %7.2f ms/frame, %7.1f frames/s", ms, 1000.0 / ms);
+      if (allocStatsEnabled()) {
+        printf(" | %ld frames com alocacao", allocatingFrames);
+        if (allocatingFrames > 0) {
+          failures++;
+        }
+      }
+    }
+
+    if (!o.outDir.empty()) {
+      writePpm(o.outDir + "/" + name + ".ppm", o.width, o.height, frame);
+    }
+    if (!o.goldenDir.empty()) {
+      std::string path = o.goldenDir + "/" + name + ".ppm";
+      int goldenWidth = 0, goldenHeight = 0;
+      if (!readPpm(path, goldenWidth, goldenHeight, golden)) {
+        printf(" | sem referencia %s", path.c_str());
+        failures++;
+      } else if (goldenWidth != o.width || goldenHeight != o.height) {
+        printf(" | referencia %dx%d", goldenWidth, goldenHeight);
+        failures++;
+      } else {
+        long different = countDifferentPixels(frame, golden);
+        double percent = different * 100.0 / (o.width * o.height);
+        bool pass = percent <= o.tolerancePercent;
+        printf(" | %ld pixels diferentes (%.3f%%) %s", different, percent,
+               pass ? "ok" : "FALHOU");
+        if (!pass) {
+          failures++;
+        }
+      }
+    }
+    printf("\n");
+  }
+  capture.stopRecording();
+  capture.shutdown();
+  return failures > 0 ? 1 : 0;
+}
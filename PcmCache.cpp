@@ -0,0 +1,238 @@
+#include "PcmCache.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <direct.h>
+#endif
+
+// Cabeçalho de cada arquivo do cache; o PCM começa em PCM_DATA_OFFSET
+struct PcmCacheHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t frequency;
+  uint32_t format;
+  uint32_t channels;
+  uint32_t reserved;
+  uint64_t dataBytes;
+};
+
+static const char PCM_CACHE_MAGIC[4] = {'C', 'S', 'P', 'C'};
+static const uint32_t PCM_CACHE_VERSION = 1;
+static const size_t PCM_DATA_OFFSET = 64;
+
+uint64_t hashBytes(const void *data, size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static void makeDirectories(const std::string &path) {
+  // Cria cada nível do caminho; erros de "já existe" são ignorados
+  for (size_t i = 1; i <= path.size(); ++i) {
+    if (i == path.size() || path[i] == '/') {
+      std::string level = path.substr(0, i);
+#ifndef _WIN32
+      mkdir(level.c_str(), 0755);
+#else
+      _mkdir(level.c_str());
+#endif
+    }
+  }
+}
+
+PcmCache::PcmCache() : frequency(0), format(0), channels(0) {}
+
+PcmCache::~PcmCache() { close(); }
+
+void PcmCache::configure(const std::string &dir, int freq, uint16_t fmt,
+                         int chans) {
+  directory = dir;
+  frequency = freq;
+  format = fmt;
+  channels = chans;
+  makeDirectories(directory);
+}
+
+void PcmCache::close() {
+  std::lock_guard<std::mutex> lock(mappingsMutex);
+  for (auto &m : mappings) {
+#ifndef _WIN32
+    if (m.mapped) {
+      munmap(const_cast<unsigned char *>(m.data), m.size);
+      continue;
+    }
+#endif
+    delete[] m.data;
+  }
+  mappings.clear();
+}
+
+std::string PcmCache::entryPath(uint64_t sourceHash, int maxMs) const {
+  char name[96];
+  if (maxMs > 0) {
+    snprintf(name, sizeof(name), "%016llx_%d_%x_%d_%dms.pcm",
+             static_cast<unsigned long long>(sourceHash), frequency, format,
+             channels, maxMs);
+  } else {
+    snprintf(name, sizeof(name), "%016llx_%d_%x_%d.pcm",
+             static_cast<unsigned long long>(sourceHash), frequency, format,
+             channels);
+  }
+  return directory + name;
+}
+
+Mix_Chunk *PcmCache::mapEntry(const std::string &path) {
+  const unsigned char *data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)PCM_DATA_OFFSET) {
+    ::close(fd);
+    return nullptr;
+  }
+  void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    return nullptr;
+  }
+  data = static_cast<const unsigned char *>(map);
+  size = static_cast<size_t>(st.st_size);
+  mapped = true;
+#else
+  FILE *file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return nullptr;
+  }
+  fseek(file, 0, SEEK_END);
+  long length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (length < (long)PCM_DATA_OFFSET) {
+    fclose(file);
+    return nullptr;
+  }
+  unsigned char *buffer = new unsigned char[length];
+  size_t got = fread(buffer, 1, length, file);
+  fclose(file);
+  if (got != (size_t)length) {
+    delete[] buffer;
+    return nullptr;
+  }
+  data = buffer;
+  size = static_cast<size_t>(length);
+#endif
+
+  // Descarta entradas truncadas ou de outro formato de saída
+  PcmCacheHeader header;
+  memcpy(&header, data, sizeof(header));
+  bool valid = memcmp(header.magic, PCM_CACHE_MAGIC, 4) == 0 &&
+               header.version == PCM_CACHE_VERSION &&
+               header.frequency == static_cast<uint32_t>(frequency) &&
+               header.format == format &&
+               header.channels == static_cast<uint32_t>(channels) &&
+               header.dataBytes == size - PCM_DATA_OFFSET;
+
+  if (!valid) {
+#ifndef _WIN32
+    munmap(const_cast<unsigned char *>(data), size);
+#else
+    delete[] data;
+#endif
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    mappings.push_back({data, size, mapped});
+  }
+
+  // O chunk apenas referencia a memória mapeada (allocated == 0), então
+  // Mix_FreeChunk não tenta liberá-la
+  return Mix_QuickLoad_RAW(const_cast<Uint8 *>(data + PCM_DATA_OFFSET),
+                           static_cast<Uint32>(header.dataBytes));
+}
+
+bool PcmCache::writeEntry(const std::string &path, const Mix_Chunk *decoded,
+                          size_t bytes) {
+  // Grava em um arquivo temporário e renomeia, para nunca deixar uma
+  // entrada pela metade se o jogo for fechado durante a gravação
+  std::string tempPath = path + ".tmp";
+  FILE *file = fopen(tempPath.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  unsigned char headerBlock[PCM_DATA_OFFSET];
+  memset(headerBlock, 0, sizeof(headerBlock));
+  PcmCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, PCM_CACHE_MAGIC, 4);
+  header.version = PCM_CACHE_VERSION;
+  header.frequency = frequency;
+  header.format = format;
+  header.channels = channels;
+  header.dataBytes = bytes;
+  memcpy(headerBlock, &header, sizeof(header));
+
+  bool ok = fwrite(headerBlock, 1, sizeof(headerBlock), file) ==
+                sizeof(headerBlock) &&
+            fwrite(decoded->abuf, 1, bytes, file) == bytes;
+  ok = (fclose(file) == 0) && ok;
+  if (!ok) {
+    remove(tempPath.c_str());
+    return false;
+  }
+  remove(path.c_str()); // rename não substitui no Windows
+  return rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+Mix_Chunk *PcmCache::load(const void *source, size_t sourceSize, int maxMs) {
+  if (directory.empty()) {
+    return nullptr;
+  }
+
+  std::string path = entryPath(hashBytes(source, sourceSize), maxMs);
+  Mix_Chunk *chunk = mapEntry(path);
+  if (chunk) {
+    return chunk;
+  }
+
+  // Primeira execução: decodifica tudo uma vez e grava no cache (só o
+  // trecho pedido; o resto da decodificação é descartado aqui mesmo)
+  Mix_Chunk *decoded = Mix_LoadWAV_RW(
+      SDL_RWFromConstMem(source, static_cast<int>(sourceSize)), 1);
+  if (!decoded) {
+    return nullptr;
+  }
+  size_t bytes = decoded->alen;
+  if (maxMs > 0) {
+    size_t frameBytes = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+    size_t limit = static_cast<size_t>(frequency) * maxMs / 1000 * frameBytes;
+    if (limit < bytes) {
+      bytes = limit;
+    }
+  }
+  bool written = writeEntry(path, decoded, bytes);
+  Mix_FreeChunk(decoded);
+  if (!written) {
+    fprintf(stderr, "Aviso: nao foi possivel gravar o cache PCM %s\n",
+            path.c_str());
+    return nullptr;
+  }
+  return mapEntry(path);
+}
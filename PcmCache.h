@@ -0,0 +1,52 @@
+#ifndef PCM_CACHE_H
+#define PCM_CACHE_H
+
+#include <SDL2/SDL_mixer.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Cache em disco de músicas já decodificadas para PCM no formato do
+// dispositivo. Cada arquivo é identificado pelo hash do arquivo original e
+// pelo formato de saída, e é mapeado em memória ao ser usado, de modo que
+// tocar a música não exige decodificação.
+class PcmCache {
+private:
+  struct Mapping {
+    const unsigned char *data;
+    size_t size;
+    bool mapped;
+  };
+
+  std::string directory;
+  int frequency;
+  uint16_t format;
+  int channels;
+  std::vector<Mapping> mappings;
+  std::mutex mappingsMutex; // Usado pelas threads de carregamento
+
+  std::string entryPath(uint64_t sourceHash, int maxMs) const;
+  Mix_Chunk *mapEntry(const std::string &path);
+  bool writeEntry(const std::string &path, const Mix_Chunk *decoded,
+                  size_t bytes);
+
+public:
+  PcmCache();
+  ~PcmCache();
+
+  // Define o diretório e o formato de saída (de Mix_QuerySpec)
+  void configure(const std::string &dir, int freq, uint16_t fmt, int chans);
+  void close(); // Só depois de liberar os chunks devolvidos por load()
+
+  // Devolve um chunk que aponta para o PCM mapeado, decodificando e
+  // gravando no cache na primeira vez. nullptr se não for possível.
+  // maxMs > 0 guarda só os primeiros maxMs milissegundos da música.
+  Mix_Chunk *load(const void *source, size_t sourceSize, int maxMs = 0);
+};
+
+// Hash FNV-1a de 64 bits
+uint64_t hashBytes(const void *data, size_t size);
+
+#endif // PCM_CACHE_H
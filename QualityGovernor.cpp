@@ -0,0 +1,128 @@
+#include "QualityGovernor.h"
+#include <cstdio>
+
+const QualitySettings QUALITY_LEVELS[QUALITY_LEVEL_COUNT] = {
+    // nome, chuva (1 a cada N ticks, máximo), LOD das partículas,
+    // janelas, multisample, suavização de linhas
+    {"minima", 4, 300, 2, 4, false, false},
+    {"baixa", 3, 600, 1, 2, false, false},
+    {"media", 2, 900, 0, 1, false, true},
+    {"alta", TRASH_RAIN_EMISSION_ODDS, TRASH_RAIN_MAX_PARTICLES, 0, 1, true,
+     true},
+};
+
+// Limites em fração do orçamento do frame (1000 / QUALITY_TARGET_FPS ms) e
+// do tick. A faixa entre "ruim" e "folgada" não muda nada.
+const double BAD_RENDER_FRACTION = 0.6;
+const double GOOD_RENDER_FRACTION = 0.3;
+const double BAD_LATE_FRACTION = 0.2;
+const double GOOD_LATE_FRACTION = 0.05;
+const double BAD_TICK_FRACTION = 0.5;
+const double GOOD_TICK_FRACTION = 0.25;
+const int BAD_WINDOWS_TO_DEGRADE = 2;
+const int MIN_UPGRADE_WINDOWS = 5;    // ~5 s a 60 fps
+const int MAX_UPGRADE_WINDOWS = 80;
+const int UPGRADE_PROBATION_WINDOWS = 10; // Queda logo após subir
+
+QualityGovernor::QualityGovernor()
+    : fixedLevel(-1), currentLevel(QUALITY_LEVEL_COUNT - 1), frames(0),
+      lateFrames(0), intervalSum(0), renderSum(0), tickSum(0), badWindows(0),
+      goodWindows(0), upgradeWindows(MIN_UPGRADE_WINDOWS),
+      windowsSinceUpgrade(UPGRADE_PROBATION_WINDOWS) {
+  lastStats.fps = 0;
+  lastStats.frameMs = 0;
+  lastStats.renderMs = 0;
+  lastStats.tickMs = 0;
+  lastStats.lateFraction = 0;
+}
+
+void QualityGovernor::setFixedLevel(int level) {
+  if (level >= QUALITY_LEVEL_COUNT) {
+    level = QUALITY_LEVEL_COUNT - 1;
+  }
+  fixedLevel = level;
+  if (level >= 0) {
+    currentLevel = level;
+    printf("Qualidade: fixa em %s\n", settings().name);
+  }
+}
+
+bool QualityGovernor::recordFrame(double intervalMs, double renderMs,
+                                  double tickMs) {
+  const double budgetMs = 1000.0 / QUALITY_TARGET_FPS;
+  frames++;
+  intervalSum += intervalMs;
+  renderSum += renderMs;
+  tickSum += tickMs;
+  if (intervalMs > budgetMs * QUALITY_LATE_FRAME_FACTOR) {
+    lateFrames++;
+  }
+  if (frames < QUALITY_WINDOW_FRAMES) {
+    return false;
+  }
+
+  int before = currentLevel;
+  closeWindow();
+  return currentLevel != before;
+}
+
+void QualityGovernor::closeWindow() {
+  lastStats.frameMs = intervalSum / frames;
+  lastStats.fps = lastStats.frameMs > 0 ? 1000.0 / lastStats.frameMs : 0;
+  lastStats.renderMs = renderSum / frames;
+  lastStats.tickMs = tickSum / frames;
+  lastStats.lateFraction = static_cast<double>(lateFrames) / frames;
+  frames = 0;
+  lateFrames = 0;
+  intervalSum = renderSum = tickSum = 0;
+  windowsSinceUpgrade++;
+
+  if (!isAdaptive()) {
+    return;
+  }
+
+  const double budgetMs = 1000.0 / QUALITY_TARGET_FPS;
+  const double tickBudgetMs = SIMULATION_TICK_MS;
+  bool bad = lastStats.renderMs > budgetMs * BAD_RENDER_FRACTION ||
+             lastStats.lateFraction > BAD_LATE_FRACTION ||
+             lastStats.tickMs > tickBudgetMs * BAD_TICK_FRACTION;
+  bool good = lastStats.renderMs < budgetMs * GOOD_RENDER_FRACTION &&
+              lastStats.lateFraction < GOOD_LATE_FRACTION &&
+              lastStats.tickMs < tickBudgetMs * GOOD_TICK_FRACTION;
+
+  if (bad) {
+    goodWindows = 0;
+    if (++badWindows >= BAD_WINDOWS_TO_DEGRADE && currentLevel > 0) {
+      // O nível que acabou de subir não se sustentou: espera mais da
+      // próxima vez
+      if (windowsSinceUpgrade < UPGRADE_PROBATION_WINDOWS &&
+          upgradeWindows < MAX_UPGRADE_WINDOWS) {
+        upgradeWindows *= 2;
+      }
+      changeLevel(currentLevel - 1, "abaixo da meta");
+    }
+  } else if (good) {
+    badWindows = 0;
+    if (++goodWindows >= upgradeWindows &&
+        currentLevel < QUALITY_LEVEL_COUNT - 1) {
+      windowsSinceUpgrade = 0;
+      changeLevel(currentLevel + 1, "com folga");
+    }
+  } else {
+    badWindows = 0;
+    goodWindows = 0;
+  }
+}
+
+void QualityGovernor::changeLevel(int newLevel, const char *reason) {
+  printf("Qualidade: %s -> %s (%s: %.1f fps, frame %.1f ms, desenho %.1f ms, "
+         "tick %.2f ms, %.0f%% atrasados; subir exige %d s folgados)\n",
+         QUALITY_LEVELS[currentLevel].name, QUALITY_LEVELS[newLevel].name,
+         reason, lastStats.fps, lastStats.frameMs, lastStats.renderMs,
+         lastStats.tickMs, lastStats.lateFraction * 100.0,
+         upgradeWindows * QUALITY_WINDOW_FRAMES / QUALITY_TARGET_FPS);
+  fflush(stdout);
+  currentLevel = newLevel;
+  badWindows = 0;
+  goodWindows = 0;
+}
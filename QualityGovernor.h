@@ -0,0 +1,71 @@
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include "GameConstants.h"
+
+// Um nível de qualidade visual. Os dois primeiros campos valem para a
+// simulação (chuva de lixo do game over); o resto só para o desenho.
+struct QualitySettings {
+  const char *name;
+  int rainEmissionOdds; // Uma partícula de chuva a cada N ticks, em média
+  int rainMaxParticles;
+  int particleLodBias;  // Níveis de detalhe a menos nas partículas
+  int windowStride;     // Desenha 1 a cada N janelas (1 = todas, mais as apagadas)
+  bool multisample;
+  bool lineSmooth;
+};
+
+// Do mais leve (0) ao mais bonito (QUALITY_LEVEL_COUNT - 1)
+extern const QualitySettings QUALITY_LEVELS[QUALITY_LEVEL_COUNT];
+
+// Médias da última janela de medição (overlay do F3)
+struct FrameStats {
+  double fps;
+  double frameMs;  // Intervalo entre frames
+  double renderMs; // CPU gasta em display() antes da troca de buffers
+  double tickMs;   // Custo do passo da simulação
+  double lateFraction; // Frames que passaram de QUALITY_LATE_FRAME_FACTOR
+};
+
+// Ajusta a qualidade para segurar QUALITY_TARGET_FPS. A cada
+// QUALITY_WINDOW_FRAMES frames olha as médias: duas janelas ruins seguidas
+// baixam um nível; subir exige uma sequência de janelas folgadas, que dobra
+// de tamanho se o nível novo cair logo em seguida (sem ping-pong entre dois
+// níveis). Cada decisão é registrada no stdout.
+class QualityGovernor {
+public:
+  QualityGovernor();
+
+  // --quality N: nível fixo, sem adaptação (-1 volta ao automático)
+  void setFixedLevel(int level);
+  bool isAdaptive() const { return fixedLevel < 0; }
+
+  // Um frame desenhado. Devolve true quando o nível mudou.
+  bool recordFrame(double intervalMs, double renderMs, double tickMs);
+
+  int level() const { return currentLevel; }
+  const QualitySettings &settings() const {
+    return QUALITY_LEVELS[currentLevel];
+  }
+  const FrameStats &stats() const { return lastStats; }
+
+private:
+  void closeWindow();
+  void changeLevel(int newLevel, const char *reason);
+
+  int fixedLevel;
+  int currentLevel;
+
+  // Janela em andamento
+  int frames;
+  int lateFrames;
+  double intervalSum, renderSum, tickSum;
+
+  FrameStats lastStats;
+  int badWindows;     // Janelas ruins seguidas
+  int goodWindows;    // Janelas folgadas seguidas
+  int upgradeWindows; // Folgadas necessárias para subir
+  int windowsSinceUpgrade;
+};
+
+#endif // QUALITY_GOVERNOR_H
@@ -1,10 +1,22 @@
 #include "RankingSystem.h"
 #include "GameConstants.h"
+#include "MemoryStats.h"
 #include <algorithm>
 #include <cstdio>
 #include <fstream>
 #include <sstream>
 
+// O ranking carregado (o global do jogo; as cópias são de quem as faz)
+static MemoryAccount rankingMemory(MEMORY_RANKING);
+
+size_t rankingMemoryBytes(const std::vector<PlayerScore> &ranking) {
+  size_t bytes = vectorBytes(ranking);
+  for (size_t i = 0; i < ranking.size(); ++i) {
+    bytes += stringHeapBytes(ranking[i].name);
+  }
+  return bytes;
+}
+
 void loadRanking(std::vector<PlayerScore> &ranking) {
   std::ifstream inFile(RANKING_FILENAME);
   if (!inFile.is_open()) {
@@ -27,6 +39,7 @@ void loadRanking(std::vector<PlayerScore> &ranking) {
             [](const PlayerScore &a, const PlayerScore &b) {
               return a.score > b.score;
             });
+  rankingMemory.track(rankingMemoryBytes(ranking));
 }
 
 void saveRanking(const std::string &playerName, int finalScore,
@@ -38,6 +51,7 @@ void saveRanking(const std::string &playerName, int finalScore,
             [](const PlayerScore &a, const PlayerScore &b) {
               return a.score > b.score;
             });
+  rankingMemory.track(rankingMemoryBytes(ranking));
 
   std::ofstream outFile(RANKING_FILENAME);
   if (!outFile.is_open()) {
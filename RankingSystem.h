@@ -8,5 +8,7 @@
 void loadRanking(std::vector<PlayerScore> &ranking);
 void saveRanking(const std::string &playerName, int finalScore,
                  std::vector<PlayerScore> &ranking);
+// Vetor e nomes; o ranking cresce a cada partida gravada
+size_t rankingMemoryBytes(const std::vector<PlayerScore> &ranking);
 
 #endif // RANKING_SYSTEM_H
@@ -0,0 +1,278 @@
+#include "RenderQueue.h"
+#include "GameConstants.h"
+#include "GlStats.h"
+#include <algorithm>
+#include <cmath>
+
+static GLubyte toByte(float value) {
+  value = std::min(1.0f, std::max(0.0f, value));
+  return static_cast<GLubyte>(value * 255.0f + 0.5f);
+}
+
+RenderQueue::RenderQueue()
+    : currentLayer(LAYER_SKY), currentBlend(BLEND_ALPHA),
+      currentLineWidth(1.0f), pixelSize(1.0f / 300.0f),
+      primitiveMode(GL_TRIANGLES) {
+  currentColor[0] = currentColor[1] = currentColor[2] = currentColor[3] = 255;
+  transform.a = transform.d = 1.0f;
+  transform.b = transform.c = transform.tx = transform.ty = 0.0f;
+  beginFrame();
+}
+
+void RenderQueue::beginFrame() {
+  stats.primitives = 0;
+  stats.vertices = 0;
+  stats.drawCalls = 0;
+  stats.stateChanges = 0;
+}
+
+void RenderQueue::pushMatrix() { transformStack.push_back(transform); }
+
+void RenderQueue::popMatrix() {
+  if (!transformStack.empty()) {
+    transform = transformStack.back();
+    transformStack.pop_back();
+  }
+}
+
+void RenderQueue::translate(float x, float y) {
+  transform.tx += transform.a * x + transform.c * y;
+  transform.ty += transform.b * x + transform.d * y;
+}
+
+void RenderQueue::rotate(float degrees) {
+  float radians = degrees * static_cast<float>(M_PI) / 180.0f;
+  float cs = cos(radians), sn = sin(radians);
+  Transform t = transform;
+  transform.a = t.a * cs + t.c * sn;
+  transform.b = t.b * cs + t.d * sn;
+  transform.c = t.c * cs - t.a * sn;
+  transform.d = t.d * cs - t.b * sn;
+}
+
+void RenderQueue::scale(float sx, float sy) {
+  transform.a *= sx;
+  transform.b *= sx;
+  transform.c *= sy;
+  transform.d *= sy;
+}
+
+void RenderQueue::color(float r, float g, float b, float a) {
+  currentColor[0] = toByte(r);
+  currentColor[1] = toByte(g);
+  currentColor[2] = toByte(b);
+  currentColor[3] = toByte(a);
+}
+
+void RenderQueue::begin(GLenum mode) {
+  primitiveMode = mode;
+  primitive.clear();
+}
+
+void RenderQueue::vertex(float x, float y) {
+  Vertex v;
+  v.x = transform.a * x + transform.c * y + transform.tx;
+  v.y = transform.b * x + transform.d * y + transform.ty;
+  std::copy(currentColor, currentColor + 4, v.rgba);
+  primitive.push_back(v);
+}
+
+// Segmento como um retângulo de currentLineWidth pixels
+void RenderQueue::emitLine(const Vertex &from, const Vertex &to) {
+  float dx = to.x - from.x, dy = to.y - from.y;
+  float length = sqrt(dx * dx + dy * dy);
+  if (length <= 0.0f) {
+    return;
+  }
+  float half = currentLineWidth * pixelSize * 0.5f / length;
+  float nx = -dy * half, ny = dx * half;
+  Vertex a = from, b = from, c = to, d = to;
+  a.x += nx;
+  a.y += ny;
+  b.x -= nx;
+  b.y -= ny;
+  c.x -= nx;
+  c.y -= ny;
+  d.x += nx;
+  d.y += ny;
+  emit(a);
+  emit(b);
+  emit(c);
+  emit(a);
+  emit(c);
+  emit(d);
+}
+
+// Converte a primitiva para triângulos soltos, que podem ser concatenados
+// com os de outras primitivas num só draw
+void RenderQueue::end() {
+  const std::vector<Vertex> &p = primitive;
+  const size_t n = p.size();
+  size_t first = vertices.size();
+
+  switch (primitiveMode) {
+  case GL_TRIANGLES:
+    for (size_t i = 0; i + 2 < n; i += 3) {
+      emit(p[i]);
+      emit(p[i + 1]);
+      emit(p[i + 2]);
+    }
+    break;
+  case GL_QUADS:
+    for (size_t i = 0; i + 3 < n; i += 4) {
+      emit(p[i]);
+      emit(p[i + 1]);
+      emit(p[i + 2]);
+      emit(p[i]);
+      emit(p[i + 2]);
+      emit(p[i + 3]);
+    }
+    break;
+  case GL_QUAD_STRIP:
+    for (size_t i = 0; i + 3 < n; i += 2) {
+      emit(p[i]);
+      emit(p[i + 1]);
+      emit(p[i + 3]);
+      emit(p[i]);
+      emit(p[i + 3]);
+      emit(p[i + 2]);
+    }
+    break;
+  case GL_POLYGON:
+  case GL_TRIANGLE_FAN:
+    for (size_t i = 1; i + 1 < n; ++i) {
+      emit(p[0]);
+      emit(p[i]);
+      emit(p[i + 1]);
+    }
+    break;
+  case GL_LINES:
+    for (size_t i = 0; i + 1 < n; i += 2) {
+      emitLine(p[i], p[i + 1]);
+    }
+    break;
+  case GL_LINE_STRIP:
+  case GL_LINE_LOOP:
+    for (size_t i = 0; i + 1 < n; ++i) {
+      emitLine(p[i], p[i + 1]);
+    }
+    if (primitiveMode == GL_LINE_LOOP && n > 2) {
+      emitLine(p[n - 1], p[0]);
+    }
+    break;
+  default:
+    break;
+  }
+
+  stats.primitives++;
+  if (vertices.size() > first) {
+    addItem(first);
+  }
+}
+
+// Primitivas seguidas com o mesmo estado já entram como um item só
+void RenderQueue::addItem(size_t first) {
+  if (!items.empty()) {
+    Item &last = items.back();
+    if (last.layer == currentLayer && last.blend == currentBlend &&
+        last.first + last.count == first) {
+      last.count = vertices.size() - last.first;
+      return;
+    }
+  }
+  Item item;
+  item.layer = currentLayer;
+  item.blend = currentBlend;
+  item.first = first;
+  item.count = vertices.size() - first;
+  items.push_back(item);
+}
+
+struct RenderQueue::ItemOrder {
+  const std::vector<Item> *items;
+  bool operator()(size_t l, size_t r) const {
+    const Item &a = (*items)[l];
+    const Item &b = (*items)[r];
+    if (a.layer != b.layer) {
+      return a.layer < b.layer;
+    }
+    if (a.blend != b.blend) {
+      return a.blend < b.blend;
+    }
+    return l < r; // Empate pela ordem de envio
+  }
+};
+
+void RenderQueue::flush() {
+  if (items.empty()) {
+    vertices.clear();
+    return;
+  }
+
+  // Ordem estável: dentro do mesmo estado, a ordem de envio é mantida.
+  // O desempate pelo índice deixa std::sort com o mesmo resultado do
+  // stable_sort, que alocaria um buffer temporário a cada frame
+  order.resize(items.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  ItemOrder less;
+  less.items = &items;
+  std::sort(order.begin(), order.end(), less);
+
+  // Copia os vértices na ordem final; itens vizinhos com o mesmo estado
+  // viram um grupo
+  sorted.clear();
+  batches.clear();
+  for (size_t k = 0; k < order.size(); ++k) {
+    const Item &item = items[order[k]];
+    size_t start = sorted.size();
+    sorted.insert(sorted.end(), vertices.begin() + item.first,
+                  vertices.begin() + item.first + item.count);
+    if (!batches.empty()) {
+      Item &last = batches.back();
+      if (last.blend == item.blend) {
+        last.count += item.count;
+        continue;
+      }
+    }
+    Item batch = item;
+    batch.first = start;
+    batches.push_back(batch);
+  }
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+  glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &sorted[0].x);
+  glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), sorted[0].rgba);
+
+  // O código imediato pode ter mudado o estado: o primeiro grupo sempre
+  // define o blend
+  int blend = -1;
+  for (size_t k = 0; k < batches.size(); ++k) {
+    const Item &batch = batches[k];
+    if (batch.blend != blend) {
+      if (batch.blend == BLEND_ALPHA) {
+        glEnable(GL_BLEND);
+      } else {
+        glDisable(GL_BLEND);
+      }
+      blend = batch.blend;
+      stats.stateChanges++;
+    }
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.first),
+                 static_cast<GLsizei>(batch.count));
+    stats.drawCalls++;
+  }
+
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  if (blend != BLEND_ALPHA) {
+    glEnable(GL_BLEND); // O resto do jogo desenha sempre com blend
+    stats.stateChanges++;
+  }
+
+  stats.vertices += static_cast<int>(sorted.size());
+  vertices.clear();
+  items.clear();
+}
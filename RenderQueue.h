@@ -0,0 +1,109 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <GL/gl.h>
+#include <cstddef>
+#include <vector>
+
+// Camadas de desenho, de trás para frente. Dentro de uma camada a ordem
+// não importa (nada de uma primitiva precisa cobrir outra da mesma
+// camada), então o flush pode reordenar por estado.
+enum RenderLayer {
+  LAYER_SKY,
+  LAYER_BUILDINGS_BACK,
+  LAYER_WINDOWS_BACK,
+  LAYER_BUILDINGS_FRONT,
+  LAYER_WINDOWS_FRONT,
+  LAYER_GROUND,
+  LAYER_SCENERY_SHADE, // Escurecimento do cenário durante o jogo
+  LAYER_PARTICLES,
+  LAYER_OBJECTS,
+  LAYER_BASKETS,
+  LAYER_OVERLAY
+};
+
+enum BlendMode { BLEND_NONE, BLEND_ALPHA };
+
+// Contadores do frame, para o overlay do F3
+struct RenderQueueStats {
+  int primitives;   // Pares begin/end recebidos (um draw cada no modo imediato)
+  int vertices;     // Vértices enviados ao GL
+  int drawCalls;    // glDrawArrays emitidos
+  int stateChanges; // Trocas de blend
+};
+
+// Fila de primitivas com a mesma cara do modo imediato (begin, vertex,
+// color, end e uma pilha de transformações 2D). Tudo vira triângulos já
+// transformados, inclusive as linhas (retângulos da largura pedida em
+// pixels), então a ordem de envio dentro de uma camada se mantém sem
+// custar draws. flush() ordena por camada e blend, junta o que tem o
+// mesmo estado e desenha cada grupo com um único glDrawArrays. Texto e
+// botões continuam em modo imediato, depois do flush.
+class RenderQueue {
+public:
+  RenderQueue();
+
+  void beginFrame(); // Zera os contadores
+  const RenderQueueStats &frameStats() const { return stats; }
+
+  // Estado das próximas primitivas
+  void setLayer(RenderLayer layer) { currentLayer = layer; }
+  void setBlend(BlendMode blend) { currentBlend = blend; }
+  void setLineWidth(float width) { currentLineWidth = width; } // Pixels
+  void setPixelSize(float size) { pixelSize = size; } // Unidades por pixel
+
+  // Transformações (equivalentes a glPushMatrix, glTranslatef, ...)
+  void pushMatrix();
+  void popMatrix();
+  void translate(float x, float y);
+  void rotate(float degrees);
+  void scale(float sx, float sy);
+
+  void color(float r, float g, float b, float a = 1.0f);
+  void color(const GLfloat *rgba) { color(rgba[0], rgba[1], rgba[2], rgba[3]); }
+  void begin(GLenum mode);
+  void vertex(float x, float y);
+  void end();
+
+  void flush(); // Desenha e esvazia a fila
+
+private:
+  struct Vertex {
+    GLfloat x, y;
+    GLubyte rgba[4];
+  };
+  struct Transform {
+    float a, b, c, d, tx, ty; // x' = a*x + c*y + tx, y' = b*x + d*y + ty
+  };
+  struct Item {
+    int layer;
+    BlendMode blend;
+    size_t first, count; // Em vértices
+  };
+
+  struct ItemOrder;
+
+  void emit(const Vertex &v) { vertices.push_back(v); }
+  void emitLine(const Vertex &from, const Vertex &to);
+  void addItem(size_t first);
+
+  RenderLayer currentLayer;
+  BlendMode currentBlend;
+  float currentLineWidth;
+  float pixelSize;
+  GLubyte currentColor[4];
+  Transform transform;
+  std::vector<Transform> transformStack;
+
+  GLenum primitiveMode; // Modo do begin() em andamento
+  std::vector<Vertex> primitive;
+
+  std::vector<Vertex> vertices;
+  std::vector<Item> items;
+  std::vector<Vertex> sorted; // Vértices na ordem do desenho
+  std::vector<size_t> order;
+  std::vector<Item> batches; // Um glDrawArrays cada
+  RenderQueueStats stats;
+};
+
+#endif // RENDER_QUEUE_H
@@ -0,0 +1,81 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "GameConstants.h"
+#include "GameObjects.h"
+#include "World.h"
+#include <string>
+#include <vector>
+
+// Cópia imutável de tudo o que display() desenha, publicada pela thread de
+// simulação a cada tick
+struct RenderSnapshot {
+  GameState gameState;
+  int titleScore; // Pontuação no título da janela (-1 fora de jogo)
+  float tickMs;   // Custo do passo que publicou este snapshot
+
+  // Jogo
+  std::vector<FallingObject> objects;
+  Basket basket;
+  std::vector<Basket> extraBaskets; // Modo stress
+  bool stress;
+  int score, misses;
+  int difficultyLevel, scoreForNextLevel;
+
+  // Game over
+  std::vector<TrashParticle> trashRain;
+  std::vector<SettledParticle> settledRain;
+  float gameOverAnimationTimer;
+  int displayedScore, finalScoreHolder;
+  float gameOverBasketAngle, gameOverBasketY;
+
+  // Tela inicial e menus
+  std::vector<TrashParticle> homeScreenDebris;
+  float homeScreenAnimationTimer;
+  std::string currentPlayerName;
+  Button homeButton;
+  std::vector<Button> pauseButtons;
+  std::vector<PlayerScore> ranking;
+  bool assetsLoading;
+  float assetLoadProgress;
+
+  RenderSnapshot()
+      : gameState(STATE_HOME), titleScore(-1), tickMs(0), stress(false), score(0), misses(0),
+        difficultyLevel(1), scoreForNextLevel(1), gameOverAnimationTimer(0),
+        displayedScore(0), finalScoreHolder(0), gameOverBasketAngle(0),
+        gameOverBasketY(0), homeScreenAnimationTimer(0),
+        homeButton(0.0f, 0.0f, 0.0f, 0.0f, ""), assetsLoading(false),
+        assetLoadProgress(1.0f) {}
+
+  // Copia reservando de uma vez a capacidade da origem: uma atribuição
+  // simples realocaria a cada tick enquanto a chuva cresce
+  template <typename T>
+  static void copyVector(std::vector<T> &to, const std::vector<T> &from) {
+    if (to.capacity() < from.capacity()) {
+      to.reserve(from.capacity());
+    }
+    to = from;
+  }
+
+  // Campos da partida (jogo e game over)
+  void copyWorld(const World &world) {
+    copyVector(objects, world.objects);
+    basket = world.basket;
+    copyVector(extraBaskets, world.extraBaskets);
+    stress = world.isStress();
+    score = world.score;
+    misses = world.misses;
+    difficultyLevel = world.difficultyLevel;
+    scoreForNextLevel = world.scoreForNextLevel;
+
+    copyVector(trashRain, world.trashRain);
+    copyVector(settledRain, world.settledRain);
+    gameOverAnimationTimer = world.gameOverAnimationTimer;
+    displayedScore = world.displayedScore;
+    finalScoreHolder = world.finalScoreHolder;
+    gameOverBasketAngle = world.gameOverBasketAngle;
+    gameOverBasketY = world.gameOverBasketY;
+  }
+};
+
+#endif // RENDER_SNAPSHOT_H
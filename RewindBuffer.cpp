@@ -0,0 +1,502 @@
+#include "RewindBuffer.h"
+#include "AllocStats.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Campos escalares do World, sem enchimento entre eles (só tipos de 4
+// bytes), para que bytes iguais signifiquem estado igual
+struct WorldImageHeader {
+  uint32_t objectCount, particleCount, rainSlots, settledCount;
+  int32_t score, misses, gameOver, moveLeft, moveRight;
+  float speedIncreaseRate, scalingFactor;
+  int32_t spawnDelayInitial, spawnDelayMinimum, maxNumObjects;
+  float minObjectSpeed, maxObjectSpeedOffset;
+  int32_t scoreForNextLevel, difficultyLevel, spawnDelay, spawnTimer;
+  float difficultyMultiplier;
+  float basketX, basketY, basketWidth, basketHeight, basketSpeed;
+  int32_t basketWasteType;
+  float gameOverAnimationTimer;
+  int32_t displayedScore, finalScoreHolder;
+  float gameOverBasketAngle, gameOverBasketY;
+  float time;
+  uint32_t rngState;
+  int32_t stressObjects, stressBaskets;
+};
+
+static void fillHeader(const World &w, WorldImageHeader &h) {
+  h.objectCount = static_cast<uint32_t>(w.objects.size());
+  h.particleCount = static_cast<uint32_t>(w.trashRain.size());
+  // Com pilha, as partículas caindo ocupam a capacidade toda (ver capture)
+  h.rainSlots = static_cast<uint32_t>(
+      w.settledRain.empty() ? w.trashRain.size() : w.trashRain.capacity());
+  h.settledCount = static_cast<uint32_t>(w.settledRain.size());
+  h.score = w.score;
+  h.misses = w.misses;
+  h.gameOver = w.gameOver;
+  h.moveLeft = w.moveLeft;
+  h.moveRight = w.moveRight;
+  h.speedIncreaseRate = w.difficulty.speedIncreaseRate;
+  h.scalingFactor = w.difficulty.scalingFactor;
+  h.spawnDelayInitial = w.difficulty.spawnDelayInitial;
+  h.spawnDelayMinimum = w.difficulty.spawnDelayMinimum;
+  h.maxNumObjects = w.difficulty.maxNumObjects;
+  h.minObjectSpeed = w.minObjectSpeed;
+  h.maxObjectSpeedOffset = w.maxObjectSpeedOffset;
+  h.scoreForNextLevel = w.scoreForNextLevel;
+  h.difficultyLevel = w.difficultyLevel;
+  h.spawnDelay = w.spawnDelay;
+  h.spawnTimer = w.spawnTimer;
+  h.difficultyMultiplier = w.difficultyMultiplier;
+  h.basketX = w.basket.x;
+  h.basketY = w.basket.y;
+  h.basketWidth = w.basket.width;
+  h.basketHeight = w.basket.height;
+  h.basketSpeed = w.basket.speed;
+  h.basketWasteType = w.basket.wasteType;
+  h.gameOverAnimationTimer = w.gameOverAnimationTimer;
+  h.displayedScore = w.displayedScore;
+  h.finalScoreHolder = w.finalScoreHolder;
+  h.gameOverBasketAngle = w.gameOverBasketAngle;
+  h.gameOverBasketY = w.gameOverBasketY;
+  h.time = w.time;
+  h.rngState = w.rngState;
+  h.stressObjects = w.stress.objectCount;
+  h.stressBaskets = w.stress.basketCount;
+}
+
+static void applyHeader(const WorldImageHeader &h, World &w) {
+  w.score = h.score;
+  w.misses = h.misses;
+  w.gameOver = h.gameOver != 0;
+  w.moveLeft = h.moveLeft != 0;
+  w.moveRight = h.moveRight != 0;
+  w.difficulty.speedIncreaseRate = h.speedIncreaseRate;
+  w.difficulty.scalingFactor = h.scalingFactor;
+  w.difficulty.spawnDelayInitial = h.spawnDelayInitial;
+  w.difficulty.spawnDelayMinimum = h.spawnDelayMinimum;
+  w.difficulty.maxNumObjects = h.maxNumObjects;
+  w.minObjectSpeed = h.minObjectSpeed;
+  w.maxObjectSpeedOffset = h.maxObjectSpeedOffset;
+  w.scoreForNextLevel = h.scoreForNextLevel;
+  w.difficultyLevel = h.difficultyLevel;
+  w.spawnDelay = h.spawnDelay;
+  w.spawnTimer = h.spawnTimer;
+  w.difficultyMultiplier = h.difficultyMultiplier;
+  w.basket.x = h.basketX;
+  w.basket.y = h.basketY;
+  w.basket.width = h.basketWidth;
+  w.basket.height = h.basketHeight;
+  w.basket.speed = h.basketSpeed;
+  w.basket.wasteType = static_cast<WASTE_TYPE>(h.basketWasteType);
+  w.gameOverAnimationTimer = h.gameOverAnimationTimer;
+  w.displayedScore = h.displayedScore;
+  w.finalScoreHolder = h.finalScoreHolder;
+  w.gameOverBasketAngle = h.gameOverBasketAngle;
+  w.gameOverBasketY = h.gameOverBasketY;
+  w.time = h.time;
+  w.rngState = h.rngState;
+  w.stress.objectCount = h.stressObjects;
+  w.stress.basketCount = h.stressBaskets;
+  w.extraBaskets.resize(h.stressBaskets, Basket());
+  w.placeExtraBaskets();
+}
+
+// Grava o XOR entre os trechos (a imagem nova) e last (a anterior) como
+// pares {uint16 zeros, uint16 literais, bytes literais} e atualiza last.
+// Todos os campos têm 4 bytes, então as comparações andam de palavra em
+// palavra, e de 8 em 8 bytes nos trechos iguais. Zeros no fim não são
+// gravados: o tamanho da imagem vai no Frame.
+const size_t MAX_RUN = 0xFFFC; // Maior múltiplo de 4 que cabe em uint16
+
+static_assert(sizeof(WorldImageHeader) % 4 == 0 &&
+                  sizeof(FallingObject) % 4 == 0 &&
+                  sizeof(SettledParticle) % 4 == 0 &&
+                  sizeof(TrashParticle) % 4 == 0,
+              "a imagem do World precisa ser feita de palavras de 4 bytes");
+
+// Palavra de 4 bytes na posição i; sem origem (trecho nulo), zero
+template <bool HasSource>
+static inline uint32_t wordAt(const unsigned char *data, size_t i) {
+  uint32_t value = 0;
+  if (HasSource) {
+    memcpy(&value, data + i, 4);
+  }
+  return value;
+}
+
+template <bool HasSource>
+static inline uint64_t pairAt(const unsigned char *data, size_t i) {
+  uint64_t value = 0;
+  if (HasSource) {
+    memcpy(&value, data + i, 8);
+  }
+  return value;
+}
+
+static void reserveBytes(std::vector<unsigned char> &out, size_t used,
+                         size_t extra) {
+  if (used + extra > out.size()) {
+    if (used + extra <= out.capacity()) {
+      out.resize(out.capacity()); // Ainda cabe no que a posição já tem
+    } else {
+      // Posição do anel chegando ao seu tamanho de trabalho; depois ela é
+      // reaproveitada sem alocar
+      allocStatsAllowFrame();
+      out.resize(std::max(out.size() * 2, used + extra + 256));
+    }
+  }
+}
+
+static void putRun(std::vector<unsigned char> &out, size_t at, size_t zeros,
+                   size_t literals) {
+  uint16_t z = static_cast<uint16_t>(zeros);
+  uint16_t l = static_cast<uint16_t>(literals);
+  memcpy(&out[at], &z, 2);
+  memcpy(&out[at + 2], &l, 2);
+}
+
+// Codifica um trecho: procura as palavras diferentes e grava o XOR numa
+// passada só, já copiando a palavra nova para old
+template <bool HasSource>
+static void encodeSpan(const unsigned char *src, unsigned char *old,
+                       size_t size, std::vector<unsigned char> &out,
+                       size_t &used, size_t &zeros) {
+  size_t i = 0;
+  while (i < size) {
+    size_t equalStart = i;
+    while (i + 8 <= size &&
+           pairAt<HasSource>(src, i) == pairAt<true>(old, i)) {
+      i += 8;
+    }
+    while (i < size && wordAt<HasSource>(src, i) == wordAt<true>(old, i)) {
+      i += 4;
+    }
+    zeros += i - equalStart;
+    if (i == size) {
+      break;
+    }
+
+    for (; zeros > MAX_RUN; zeros -= MAX_RUN) {
+      reserveBytes(out, used, 4);
+      putRun(out, used, MAX_RUN, 0);
+      used += 4;
+    }
+    reserveBytes(out, used, 8);
+    size_t runAt = used;
+    size_t literalStart = i;
+    used += 4;
+    do {
+      uint32_t value = wordAt<HasSource>(src, i);
+      uint32_t x = value ^ wordAt<true>(old, i);
+      // Uma palavra igual entre duas diferentes entra como literal: custa
+      // os mesmos 4 bytes de um par novo e evita um par a mais
+      if (x == 0 && (i + 8 > size || wordAt<HasSource>(src, i + 4) ==
+                                          wordAt<true>(old, i + 4))) {
+        break;
+      }
+      reserveBytes(out, used, 4);
+      memcpy(&out[used], &x, 4);
+      memcpy(old + i, &value, 4);
+      used += 4;
+      i += 4;
+    } while (i < size && i - literalStart < MAX_RUN);
+    putRun(out, runAt, zeros, i - literalStart);
+    zeros = 0;
+  }
+}
+
+static void encodeDelta(const RewindBuffer::ImageSpan *spans,
+                        size_t spanCount, std::vector<unsigned char> &last,
+                        std::vector<unsigned char> &out) {
+  size_t newSize = 0;
+  for (size_t s = 0; s < spanCount; ++s) {
+    newSize += spans[s].size;
+  }
+  size_t oldSize = last.size();
+  size_t total = std::max(newSize, oldSize);
+  last.resize(total, 0); // O que passar do tamanho antigo vale zero
+
+  // out cresce só quando preciso e mantém a capacidade entre os ticks
+  size_t used = 0;
+  size_t zeros = 0;  // Bytes iguais ainda não gravados
+  size_t offset = 0; // Posição do trecho atual na imagem
+  for (size_t s = 0; s <= spanCount; ++s) {
+    // Depois do último trecho, os bytes da imagem antiga que sobraram
+    // (imagem encolheu) entram como XOR com zero
+    const unsigned char *src = s < spanCount ? spans[s].data : 0;
+    size_t size = s < spanCount ? spans[s].size : total - newSize;
+    if (s < spanCount && spans[s].unchanged) {
+      zeros += size;
+    } else if (size > 0 && src != 0) {
+      encodeSpan<true>(src, &last[offset], size, out, used, zeros);
+    } else if (size > 0) {
+      encodeSpan<false>(0, &last[offset], size, out, used, zeros);
+    }
+    offset += size;
+  }
+  out.resize(used);
+  last.resize(newSize);
+}
+
+// Aplica um delta (nos dois sentidos) sobre uma imagem, no lugar
+static void applyDelta(const std::vector<unsigned char> &delta,
+                       size_t fromSize, size_t toSize,
+                       std::vector<unsigned char> &image) {
+  image.resize(std::max(fromSize, toSize), 0);
+  size_t pos = 0, in = 0;
+  while (in + 4 <= delta.size()) {
+    uint16_t zeros, literals;
+    memcpy(&zeros, &delta[in], 2);
+    memcpy(&literals, &delta[in + 2], 2);
+    in += 4;
+    pos += zeros;
+    for (uint16_t k = 0; k < literals; ++k) {
+      image[pos++] ^= delta[in++];
+    }
+  }
+  image.resize(toSize);
+}
+
+RewindBuffer::RewindBuffer(size_t maxFrames, size_t memoryBudget,
+                           int keyframeInterval)
+    : frames(std::max<size_t>(maxFrames, 2)), first(0), count(0),
+      bytesUsed(0), memoryBudget(memoryBudget),
+      keyframeInterval(std::max(keyframeInterval, 1)), sinceKeyframe(0),
+      imageIndex(0), knownSettled(0), knownRainSlots(0), knownParticles(0) {
+  // Cada posição do anel já nasce com espaço para um delta típico: sem
+  // isso os deltas, que crescem aos poucos com a partida, alocariam em
+  // quase todo tick até cada posição chegar ao seu tamanho
+  for (size_t i = 0; i < frames.size(); ++i) {
+    frames[i].data.reserve(REWIND_FRAME_RESERVE);
+    bytesUsed += frames[i].data.capacity();
+  }
+}
+
+void RewindBuffer::clear() {
+  first = 0;
+  count = 0;
+  sinceKeyframe = 0;
+  imageIndex = 0;
+  knownSettled = 0;
+}
+
+void RewindBuffer::dropOldestGroup(bool releaseMemory) {
+  // Remove o keyframe mais antigo e os deltas que dependem dele
+  size_t dropped = 0;
+  do {
+    Frame &f = slot(0);
+    if (releaseMemory) {
+      bytesUsed -= f.data.capacity();
+      std::vector<unsigned char>().swap(f.data);
+    }
+    first = (first + 1) % frames.size();
+    count--;
+    dropped++;
+  } while (count > 0 && !slot(0).keyframe);
+  imageIndex = imageIndex >= dropped ? imageIndex - dropped : count;
+}
+
+bool RewindBuffer::hasSecondGroup() {
+  for (size_t i = 1; i < count; ++i) {
+    if (slot(i).keyframe) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RewindBuffer::addSpan(const void *data, size_t size, bool unchanged) {
+  if (size == 0) {
+    return;
+  }
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  if (!spans.empty() && spans.back().unchanged == unchanged &&
+      (unchanged || spans.back().data + spans.back().size == bytes)) {
+    spans.back().size += size; // Estende o trecho anterior
+    return;
+  }
+  ImageSpan span;
+  span.data = bytes;
+  span.size = size;
+  span.unchanged = unchanged;
+  spans.push_back(span);
+}
+
+void RewindBuffer::capture(const World &world) {
+  WorldImageHeader header;
+  fillHeader(world, header);
+
+  // A pilha da chuva só cresce durante o game over e nada nela muda: o que
+  // já estava no quadro anterior é igual e nem é lido, só as partículas
+  // novas entram no delta. Para a pilha ficar sempre na mesma posição da
+  // imagem, as partículas que caem antes dela ocupam a capacidade inteira
+  // do vetor (o resto são zeros, que o RLE não grava). Se a pilha encolheu
+  // ou mudou de lugar, é outra partida.
+  const std::vector<SettledParticle> &pile = world.settledRain;
+  const std::vector<TrashParticle> &rain = world.trashRain;
+  if (count == 0 || pile.size() < knownSettled ||
+      header.rainSlots != knownRainSlots) {
+    knownSettled = 0;
+    knownParticles = header.rainSlots;
+  }
+  // Dos zeros depois das partículas, só os que ocupam o lugar de partículas
+  // do quadro anterior podem ter mudado; o resto já era zero
+  size_t clearedSlots =
+      std::max(rain.size(), std::min<size_t>(knownParticles, header.rainSlots));
+
+  // A imagem nunca passa do que o World reservou: com a imagem desse
+  // tamanho, a chuva do game over cresce sem realocar nada
+  size_t imageCapacity = sizeof(header) +
+                         world.objects.capacity() * sizeof(FallingObject) +
+                         rain.capacity() * sizeof(TrashParticle) +
+                         pile.capacity() * sizeof(SettledParticle);
+  if (imageCapacity > last.capacity()) {
+    allocStatsAllowFrame();
+    last.reserve(imageCapacity);
+    image.reserve(imageCapacity); // Voltar no tempo também não aloca
+    spans.reserve(8);
+  }
+
+  spans.clear();
+  addSpan(&header, sizeof(header), false);
+  addSpan(world.objects.empty() ? 0 : &world.objects[0],
+          world.objects.size() * sizeof(FallingObject), false);
+  addSpan(rain.empty() ? 0 : &rain[0], rain.size() * sizeof(TrashParticle),
+          false);
+  addSpan(0, (clearedSlots - rain.size()) * sizeof(TrashParticle), false);
+  addSpan(0, (header.rainSlots - clearedSlots) * sizeof(TrashParticle),
+          true);
+  addSpan(0, knownSettled * sizeof(SettledParticle), true);
+  addSpan(pile.empty() ? 0 : &pile[0] + knownSettled,
+          (pile.size() - knownSettled) * sizeof(SettledParticle), false);
+  knownSettled = pile.size();
+  knownRainSlots = header.rainSlots;
+  knownParticles = rain.size();
+
+  // O primeiro quadro do anel precisa ser keyframe para poder ser lido
+  bool keyframe = count == 0 || ++sinceKeyframe >= keyframeInterval;
+  if (keyframe) {
+    sinceKeyframe = 0;
+  }
+
+  // Anel cheio: a posição liberada é reaproveitada sem alocar
+  if (count == frames.size()) {
+    dropOldestGroup(false);
+  }
+
+  Frame &frame = slot(count);
+  size_t before = frame.data.capacity();
+  frame.keyframe = keyframe;
+  frame.previousSize = count > 0 ? last.size() : 0;
+  encodeDelta(spans.empty() ? 0 : &spans[0], spans.size(), last,
+              frame.data);
+  frame.size = last.size();
+  if (keyframe) {
+    if (frame.data.capacity() < last.capacity()) {
+      allocStatsAllowFrame(); // Uma vez por posição do anel
+      frame.data.reserve(last.capacity());
+    }
+    frame.data.assign(last.begin(), last.end());
+  }
+  bytesUsed += frame.data.capacity() - before;
+  count++;
+  imageIndex = count; // A imagem em exibição deixou de ser a mais recente
+
+  // Acima do orçamento: devolve a memória dos grupos mais antigos, sempre
+  // mantendo o grupo do quadro atual
+  while (bytesUsed > memoryBudget && hasSecondGroup()) {
+    dropOldestGroup(true);
+  }
+}
+
+// Deixa em image a imagem do quadro index, andando a partir da posição
+// atual quando ela está perto e, senão, a partir do keyframe anterior
+bool RewindBuffer::loadImage(size_t index) {
+  if (index >= count) {
+    return false;
+  }
+  if (imageIndex >= count) {
+    imageIndex = count - 1;
+    image = last;
+  }
+
+  size_t key = index;
+  while (!slot(key).keyframe) {
+    key--; // slot(0) é sempre keyframe
+  }
+  // Keyframes guardam a imagem, não o delta: não dá para voltar através
+  // deles, só partir deles
+  size_t fromCurrent =
+      index <= imageIndex ? imageIndex - index : index - imageIndex;
+  for (size_t i = index + 1; i <= imageIndex && index < imageIndex; ++i) {
+    if (slot(i).keyframe) {
+      fromCurrent = count; // Caminho bloqueado
+      break;
+    }
+  }
+  if (fromCurrent > index - key) {
+    image.assign(slot(key).data.begin(), slot(key).data.end());
+    imageIndex = key;
+  }
+
+  while (imageIndex > index) {
+    const Frame &f = slot(imageIndex);
+    applyDelta(f.data, f.size, f.previousSize, image);
+    imageIndex--;
+  }
+  while (imageIndex < index) {
+    imageIndex++;
+    const Frame &f = slot(imageIndex);
+    if (f.keyframe) {
+      image.assign(f.data.begin(), f.data.end());
+    } else {
+      applyDelta(f.data, f.previousSize, f.size, image);
+    }
+  }
+  return true;
+}
+
+bool RewindBuffer::restore(size_t index, World &world) {
+  if (!loadImage(index) || image.size() < sizeof(WorldImageHeader)) {
+    return false;
+  }
+  WorldImageHeader header;
+  memcpy(&header, &image[0], sizeof(header));
+  const unsigned char *p = &image[0] + sizeof(header);
+
+  const FallingObject *objects = reinterpret_cast<const FallingObject *>(p);
+  world.objects.assign(objects, objects + header.objectCount);
+  p += header.objectCount * sizeof(FallingObject);
+
+  const TrashParticle *particles = reinterpret_cast<const TrashParticle *>(p);
+  world.trashRain.assign(particles, particles + header.particleCount);
+  p += header.rainSlots * sizeof(TrashParticle);
+
+  const SettledParticle *settled =
+      reinterpret_cast<const SettledParticle *>(p);
+  world.settledRain.assign(settled, settled + header.settledCount);
+
+  applyHeader(header, world);
+  world.events.clear();
+  return true;
+}
+
+void RewindBuffer::truncateAfter(size_t index) {
+  if (index + 1 >= count || !loadImage(index)) {
+    return;
+  }
+  count = index + 1;
+
+  // O próximo capture() faz o delta contra o quadro restaurado
+  last = image;
+  // Sem histórico da pilha nem da chuva: compara tudo uma vez
+  knownSettled = 0;
+  knownRainSlots = 0;
+  size_t key = index;
+  while (!slot(key).keyframe) {
+    key--;
+  }
+  sinceKeyframe = static_cast<int>(index - key);
+}
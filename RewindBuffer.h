@@ -0,0 +1,74 @@
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include "World.h"
+#include <cstddef>
+#include <vector>
+
+// Histórico dos últimos ticks da simulação para voltar no tempo. Cada tick
+// vira uma imagem binária do World (cabeçalho + objetos + partículas caindo
+// + pilha da chuva, sem
+// o versionamento do WorldSnapshot, pois nunca sai da memória). A cada
+// keyframeInterval ticks a imagem é guardada inteira; entre eles, só o XOR
+// com o tick anterior, compactado em sequências de zeros (RLE). Como o XOR
+// é simétrico, o mesmo delta serve para avançar e para voltar um tick, e
+// voltar tick a tick (scrub) custa um delta por passo.
+//
+// Os quadros mais antigos são descartados, um grupo (keyframe + deltas)
+// por vez, quando o anel enche ou a memória passa de memoryBudget bytes.
+class RewindBuffer {
+public:
+  // Trecho contíguo da imagem lido direto da memória do World. Trechos
+  // "unchanged" são iguais à imagem anterior por construção e nem são lidos.
+  struct ImageSpan {
+    const unsigned char *data;
+    size_t size;
+    bool unchanged;
+  };
+
+private:
+  struct Frame {
+    bool keyframe;
+    size_t size, previousSize;       // Tamanho desta imagem e da anterior
+    std::vector<unsigned char> data; // Imagem inteira ou delta RLE
+  };
+
+  std::vector<Frame> frames; // Anel; a capacidade dos vetores é reaproveitada
+  size_t first;              // Quadro mais antigo
+  size_t count;
+  size_t bytesUsed;          // Memória retida por todas as posições
+  size_t memoryBudget;
+  int keyframeInterval;
+  int sinceKeyframe;
+
+  std::vector<unsigned char> last;  // Imagem do último quadro gravado
+  std::vector<unsigned char> image; // Imagem do quadro em exibição
+  size_t imageIndex;                // Quadro que está em image (ou count)
+  size_t knownSettled;              // Tamanho da pilha no último quadro
+  size_t knownRainSlots;            // Espaço das que caíam antes dela
+  size_t knownParticles;            // Partículas caindo no último quadro
+  std::vector<ImageSpan> spans;     // Trechos da imagem do tick atual
+
+  Frame &slot(size_t index) { return frames[(first + index) % frames.size()]; }
+  void dropOldestGroup(bool releaseMemory);
+  bool hasSecondGroup();
+  bool loadImage(size_t index);
+  void addSpan(const void *data, size_t size, bool unchanged);
+
+public:
+  RewindBuffer(size_t maxFrames, size_t memoryBudget, int keyframeInterval);
+
+  void clear();
+  void capture(const World &world); // Uma vez por tick, depois da simulação
+
+  size_t getFrameCount() const { return count; }
+  size_t getMemoryUsed() const { return bytesUsed; }
+
+  // Restaura o quadro index (0 = mais antigo) sem alterar o histórico;
+  // índices vizinhos do último restaurado custam um único delta
+  bool restore(size_t index, World &world);
+  // Descarta os quadros depois de index: o jogo continua a partir dele
+  void truncateAfter(size_t index);
+};
+
+#endif // REWIND_BUFFER_H
@@ -1,10 +1,16 @@
 #include "Scenery.h"
+#include "GlStats.h"
+#include "MemoryStats.h"
+#include "RenderQueue.h"
+#include "SceneryShader.h"
 #include <GL/glut.h>
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
 
+static MemoryAccount sceneryMemory(MEMORY_SCENERY);
+
 void initUrbanScenery(std::vector<Building> &cityscape) {
   cityscape.clear();
   srand(1337); // Usa uma seed fixa para que o cenário seja sempre o mesmo
@@ -47,13 +53,21 @@ void initUrbanScenery(std::vector<Building> &cityscape) {
   std::sort(
       cityscape.begin(), cityscape.end(),
       [](const Building &a, const Building &b) { return a.layer < b.layer; });
+  sceneryMemory.track(vectorBytes(cityscape));
 
   srand(static_cast<unsigned int>(
       time(0))); // Reseta a seed para o resto do jogo ser aleatório
 }
 
-void drawUrbanScenery(const std::vector<Building> &cityscape, int windowWidth,
-                      int windowHeight) {
+void drawUrbanScenery(RenderQueue &queue,
+                      const std::vector<Building> &cityscape, int windowWidth,
+                      int windowHeight, int windowStride) {
+  if (sceneryShaderReady()) {
+    drawSceneryShader(cityscape, windowWidth, windowHeight,
+                      glutGet(GLUT_ELAPSED_TIME), windowStride);
+    return;
+  }
+
   float aspect = (float)windowWidth / (float)windowHeight;
   float worldLeft = -1.0, worldRight = 1.0, worldTop = 1.0, worldBottom = -1.0;
   (void)worldBottom; // Suprime warning - variável pode ser usada futuramente
@@ -66,27 +80,34 @@ void drawUrbanScenery(const std::vector<Building> &cityscape, int windowWidth,
     worldBottom = -1.0 / aspect;
   }
 
+  // Tudo opaco: o cenário não precisa de blend
+  queue.setBlend(BLEND_NONE);
+
   // Desenha o céu com um gradiente do escuro (topo) para o claro (horizonte)
-  glBegin(GL_QUADS);
-  glColor3f(0.1f, 0.1f, 0.3f);
-  glVertex2f(worldLeft, worldTop);
-  glVertex2f(worldRight, worldTop);
-  glColor3f(0.9f, 0.7f, 0.4f);
-  glVertex2f(worldRight, -0.7f);
-  glVertex2f(worldLeft, -0.7f);
-  glEnd();
+  queue.setLayer(LAYER_SKY);
+  queue.begin(GL_QUADS);
+  queue.color(0.1f, 0.1f, 0.3f);
+  queue.vertex(worldLeft, worldTop);
+  queue.vertex(worldRight, worldTop);
+  queue.color(0.9f, 0.7f, 0.4f);
+  queue.vertex(worldRight, -0.7f);
+  queue.vertex(worldLeft, -0.7f);
+  queue.end();
 
   int time_ms = glutGet(GLUT_ELAPSED_TIME);
 
-  // Desenha cada prédio
+  // Desenha cada prédio. As janelas ficam numa camada logo acima dos
+  // prédios da mesma fileira; os da fileira da frente cobrem as de trás.
   for (const auto &b : cityscape) {
-    glColor3f(b.r, b.g, b.b);
-    glBegin(GL_QUADS);
-    glVertex2f(b.x_pos, -0.8f);
-    glVertex2f(b.x_pos + b.width, -0.8f);
-    glVertex2f(b.x_pos + b.width, b.height);
-    glVertex2f(b.x_pos, b.height);
-    glEnd();
+    queue.setLayer(b.layer == 0 ? LAYER_BUILDINGS_BACK
+                                : LAYER_BUILDINGS_FRONT);
+    queue.color(b.r, b.g, b.b);
+    queue.begin(GL_QUADS);
+    queue.vertex(b.x_pos, -0.8f);
+    queue.vertex(b.x_pos + b.width, -0.8f);
+    queue.vertex(b.x_pos + b.width, b.height);
+    queue.vertex(b.x_pos, b.height);
+    queue.end();
 
     // Desenha as janelas
     float window_margin = 0.1f * b.width;
@@ -94,33 +115,41 @@ void drawUrbanScenery(const std::vector<Building> &cityscape, int windowWidth,
     int num_floors = static_cast<int>((b.height + 0.8f) / 0.1f);
     int num_windows_per_floor =
         static_cast<int>((b.width - 2 * window_margin) / (window_size * 1.5f));
+    queue.setLayer(b.layer == 0 ? LAYER_WINDOWS_BACK : LAYER_WINDOWS_FRONT);
 
     for (int i = 0; i < num_floors; ++i) {
       for (int j = 0; j < num_windows_per_floor; ++j) {
+        if ((i + j) % windowStride != 0) {
+          continue;
+        }
         int window_seed = static_cast<int>(b.x_pos * 100) + i * 13 + j * 7;
         if (sin((time_ms / 1000.0f) * 0.2f + window_seed) > 0.8) {
-          glColor3f(0.9f, 0.9f, 0.6f);
+          queue.color(0.9f, 0.9f, 0.6f);
+        } else if (windowStride == 1) {
+          queue.color(b.r * 0.5f, b.g * 0.5f, b.b * 0.5f);
         } else {
-          glColor3f(b.r * 0.5f, b.g * 0.5f, b.b * 0.5f);
+          continue; // Qualidade reduzida: janelas apagadas não são desenhadas
         }
         float wx = b.x_pos + window_margin + j * (window_size * 1.5f);
         float wy = -0.75f + i * 0.1f;
-        glBegin(GL_QUADS);
-        glVertex2f(wx, wy);
-        glVertex2f(wx + window_size, wy);
-        glVertex2f(wx + window_size, wy + 0.05f);
-        glVertex2f(wx, wy + 0.05f);
-        glEnd();
+        queue.begin(GL_QUADS);
+        queue.vertex(wx, wy);
+        queue.vertex(wx + window_size, wy);
+        queue.vertex(wx + window_size, wy + 0.05f);
+        queue.vertex(wx, wy + 0.05f);
+        queue.end();
       }
     }
   }
 
   // Desenha a rua/chão
-  glColor3f(0.2f, 0.2f, 0.2f);
-  glBegin(GL_QUADS);
-  glVertex2f(worldLeft, -1.0f);
-  glVertex2f(worldRight, -1.0f);
-  glVertex2f(worldRight, -0.8f);
-  glVertex2f(worldLeft, -0.8f);
-  glEnd();
+  queue.setLayer(LAYER_GROUND);
+  queue.color(0.2f, 0.2f, 0.2f);
+  queue.begin(GL_QUADS);
+  queue.vertex(worldLeft, -1.0f);
+  queue.vertex(worldRight, -1.0f);
+  queue.vertex(worldRight, -0.8f);
+  queue.vertex(worldLeft, -0.8f);
+  queue.end();
+  queue.setBlend(BLEND_ALPHA);
 }
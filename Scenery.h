@@ -4,9 +4,15 @@
 #include "GameObjects.h"
 #include <vector>
 
+class RenderQueue;
+
 // Funções do cenário
 void initUrbanScenery(std::vector<Building> &cityscape);
-void drawUrbanScenery(const std::vector<Building> &cityscape, int windowWidth,
-                      int windowHeight);
+// windowStride: desenha 1 a cada N janelas; acima de 1, só as acesas
+// Só enfileira; o desenho sai no flush da tela atual. Com o caminho em
+// GLSL ligado (initSceneryShader), desenha na hora e não usa a fila
+void drawUrbanScenery(RenderQueue &queue,
+                      const std::vector<Building> &cityscape, int windowWidth,
+                      int windowHeight, int windowStride);
 
 #endif // SCENERY_H
@@ -0,0 +1,268 @@
+#include "SceneryShader.h"
+#include "GlStats.h"
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+#include <GL/glext.h>
+#include <cstdio>
+#include <cstring>
+
+// Funções do GL 2.0, carregadas em tempo de execução como na FrameCapture
+static PFNGLCREATESHADERPROC createShader = NULL;
+static PFNGLSHADERSOURCEPROC shaderSource = NULL;
+static PFNGLCOMPILESHADERPROC compileShader = NULL;
+static PFNGLGETSHADERIVPROC getShaderiv = NULL;
+static PFNGLGETSHADERINFOLOGPROC getShaderInfoLog = NULL;
+static PFNGLCREATEPROGRAMPROC createProgram = NULL;
+static PFNGLATTACHSHADERPROC attachShader = NULL;
+static PFNGLLINKPROGRAMPROC linkProgram = NULL;
+static PFNGLGETPROGRAMIVPROC getProgramiv = NULL;
+static PFNGLGETPROGRAMINFOLOGPROC getProgramInfoLog = NULL;
+static PFNGLUSEPROGRAMPROC useProgram = NULL;
+static PFNGLGETUNIFORMLOCATIONPROC getUniformLocation = NULL;
+static PFNGLUNIFORM1FPROC uniform1f = NULL;
+
+static bool ready = false;
+static GLuint skyProgram = 0, buildingProgram = 0;
+static GLint skyTopUniform = -1, flickerUniform = -1, strideUniform = -1;
+
+// Display list dos prédios, refeita só se o cenário mudar
+static GLuint buildingList = 0;
+static const Building *listedBuildings = NULL;
+static size_t listedCount = 0;
+
+static const char *const SKY_VERTEX_SHADER =
+    "#version 120\n"
+    "varying float worldY;\n"
+    "void main() {\n"
+    "  worldY = gl_Vertex.y;\n"
+    "  gl_Position = ftransform();\n"
+    "}\n";
+
+// Gradiente do céu até -0.7, chão entre -1.0 e -0.8; o resto fica com a
+// cor do glClear, como no caminho da CPU
+static const char *const SKY_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform float skyTop;\n"
+    "varying float worldY;\n"
+    "void main() {\n"
+    "  if (worldY >= -0.7) {\n"
+    "    float t = (worldY + 0.7) / (skyTop + 0.7);\n"
+    "    gl_FragColor = vec4(mix(vec3(0.9, 0.7, 0.4), vec3(0.1, 0.1, 0.3), "
+    "t), 1.0);\n"
+    "  } else if (worldY >= -1.0 && worldY <= -0.8) {\n"
+    "    gl_FragColor = vec4(0.2, 0.2, 0.2, 1.0);\n"
+    "  } else {\n"
+    "    discard;\n"
+    "  }\n"
+    "}\n";
+
+// params: x do prédio, largura, janelas por andar, andares
+static const char *const BUILDING_VERTEX_SHADER =
+    "#version 120\n"
+    "varying vec2 world;\n"
+    "varying vec4 params;\n"
+    "void main() {\n"
+    "  world = gl_Vertex.xy;\n"
+    "  params = gl_MultiTexCoord0;\n"
+    "  gl_FrontColor = gl_Color;\n"
+    "  gl_Position = ftransform();\n"
+    "}\n";
+
+// Mesma grade e mesmo pisca de drawUrbanScenery(): janela acesa quando
+// sin(segundos * 0.2 + semente) > 0.8
+static const char *const BUILDING_FRAGMENT_SHADER =
+    "#version 120\n"
+    "uniform float flicker;\n"
+    "uniform float windowStride;\n"
+    "varying vec2 world;\n"
+    "varying vec4 params;\n"
+    "void main() {\n"
+    "  vec3 color = gl_Color.rgb;\n"
+    "  float margin = 0.1 * params.y;\n"
+    "  float size = 0.08 * params.y;\n"
+    "  float row = floor((world.y + 0.75) / 0.1);\n"
+    "  float column = floor((world.x - params.x - margin) / (size * 1.5));\n"
+    "  if (row >= 0.0 && row < params.w && column >= 0.0 &&\n"
+    "      column < params.z &&\n"
+    "      world.x < params.x + margin + column * size * 1.5 + size &&\n"
+    "      world.y < -0.75 + row * 0.1 + 0.05 &&\n"
+    "      mod(row + column, windowStride) == 0.0) {\n"
+    "    float seed = float(int(params.x * 100.0)) + row * 13.0 + column * "
+    "7.0;\n"
+    "    if (sin(flicker + seed) > 0.8) {\n"
+    "      color = vec3(0.9, 0.9, 0.6);\n"
+    "    } else if (windowStride == 1.0) {\n"
+    "      color *= 0.5;\n"
+    "    }\n"
+    "  }\n"
+    "  gl_FragColor = vec4(color, 1.0);\n"
+    "}\n";
+
+static GLuint compile(GLenum type, const char *source) {
+  GLuint shader = createShader(type);
+  shaderSource(shader, 1, &source, NULL);
+  compileShader(shader);
+  GLint ok = GL_FALSE;
+  getShaderiv(shader, GL_COMPILE_STATUS, &ok);
+  if (!ok) {
+    char log[1024];
+    getShaderInfoLog(shader, sizeof(log), NULL, log);
+    fprintf(stderr, "Erro ao compilar shader do cenario:\n%s\n", log);
+    return 0;
+  }
+  return shader;
+}
+
+static GLuint link(const char *vertexSource, const char *fragmentSource) {
+  GLuint vertex = compile(GL_VERTEX_SHADER, vertexSource);
+  GLuint fragment = compile(GL_FRAGMENT_SHADER, fragmentSource);
+  if (!vertex || !fragment) {
+    return 0;
+  }
+  GLuint program = createProgram();
+  attachShader(program, vertex);
+  attachShader(program, fragment);
+  linkProgram(program);
+  GLint ok = GL_FALSE;
+  getProgramiv(program, GL_LINK_STATUS, &ok);
+  if (!ok) {
+    char log[1024];
+    getProgramInfoLog(program, sizeof(log), NULL, log);
+    fprintf(stderr, "Erro ao ligar shader do cenario:\n%s\n", log);
+    return 0;
+  }
+  return program;
+}
+
+bool initSceneryShader() {
+  ready = false;
+  const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+  const char *glslVersion = reinterpret_cast<const char *>(
+      glGetString(GL_SHADING_LANGUAGE_VERSION));
+  int major = 0, minor = 0, glslMajor = 0, glslMinor = 0;
+  if (version) {
+    sscanf(version, "%d.%d", &major, &minor);
+  }
+  if (glslVersion) {
+    sscanf(glslVersion, "%d.%d", &glslMajor, &glslMinor);
+  }
+
+  createShader = reinterpret_cast<PFNGLCREATESHADERPROC>(
+      glutGetProcAddress("glCreateShader"));
+  shaderSource = reinterpret_cast<PFNGLSHADERSOURCEPROC>(
+      glutGetProcAddress("glShaderSource"));
+  compileShader = reinterpret_cast<PFNGLCOMPILESHADERPROC>(
+      glutGetProcAddress("glCompileShader"));
+  getShaderiv = reinterpret_cast<PFNGLGETSHADERIVPROC>(
+      glutGetProcAddress("glGetShaderiv"));
+  getShaderInfoLog = reinterpret_cast<PFNGLGETSHADERINFOLOGPROC>(
+      glutGetProcAddress("glGetShaderInfoLog"));
+  createProgram = reinterpret_cast<PFNGLCREATEPROGRAMPROC>(
+      glutGetProcAddress("glCreateProgram"));
+  attachShader = reinterpret_cast<PFNGLATTACHSHADERPROC>(
+      glutGetProcAddress("glAttachShader"));
+  linkProgram = reinterpret_cast<PFNGLLINKPROGRAMPROC>(
+      glutGetProcAddress("glLinkProgram"));
+  getProgramiv = reinterpret_cast<PFNGLGETPROGRAMIVPROC>(
+      glutGetProcAddress("glGetProgramiv"));
+  getProgramInfoLog = reinterpret_cast<PFNGLGETPROGRAMINFOLOGPROC>(
+      glutGetProcAddress("glGetProgramInfoLog"));
+  useProgram = reinterpret_cast<PFNGLUSEPROGRAMPROC>(
+      glutGetProcAddress("glUseProgram"));
+  getUniformLocation = reinterpret_cast<PFNGLGETUNIFORMLOCATIONPROC>(
+      glutGetProcAddress("glGetUniformLocation"));
+  uniform1f = reinterpret_cast<PFNGLUNIFORM1FPROC>(
+      glutGetProcAddress("glUniform1f"));
+
+  bool supported = major >= 2 &&
+                   (glslMajor > 1 || (glslMajor == 1 && glslMinor >= 20));
+  if (!supported || !createShader || !shaderSource || !compileShader ||
+      !getShaderiv || !getShaderInfoLog || !createProgram || !attachShader ||
+      !linkProgram || !getProgramiv || !getProgramInfoLog || !useProgram ||
+      !getUniformLocation || !uniform1f) {
+    printf("Cenario: sem GLSL 1.20, desenho pela CPU\n");
+    return false;
+  }
+
+  skyProgram = link(SKY_VERTEX_SHADER, SKY_FRAGMENT_SHADER);
+  buildingProgram = link(BUILDING_VERTEX_SHADER, BUILDING_FRAGMENT_SHADER);
+  if (!skyProgram || !buildingProgram) {
+    printf("Cenario: shaders indisponiveis, desenho pela CPU\n");
+    return false;
+  }
+  skyTopUniform = getUniformLocation(skyProgram, "skyTop");
+  flickerUniform = getUniformLocation(buildingProgram, "flicker");
+  strideUniform = getUniformLocation(buildingProgram, "windowStride");
+  ready = true;
+  printf("Cenario: shaders GLSL %s\n", glslVersion);
+  return true;
+}
+
+bool sceneryShaderReady() { return ready; }
+
+// Um quad por prédio, com cor e parâmetros das janelas por vértice
+static void buildList(const std::vector<Building> &cityscape) {
+  if (!buildingList) {
+    buildingList = glGenLists(1);
+  }
+  glNewList(buildingList, GL_COMPILE);
+  glBegin(GL_QUADS);
+  for (const auto &b : cityscape) {
+    float window_margin = 0.1f * b.width;
+    float window_size = 0.08f * b.width;
+    int num_floors = static_cast<int>((b.height + 0.8f) / 0.1f);
+    int num_windows_per_floor =
+        static_cast<int>((b.width - 2 * window_margin) / (window_size * 1.5f));
+    glColor3f(b.r, b.g, b.b);
+    glTexCoord4f(b.x_pos, b.width, static_cast<float>(num_windows_per_floor),
+                 static_cast<float>(num_floors));
+    glVertex2f(b.x_pos, -0.8f);
+    glVertex2f(b.x_pos + b.width, -0.8f);
+    glVertex2f(b.x_pos + b.width, b.height);
+    glVertex2f(b.x_pos, b.height);
+  }
+  glEnd();
+  glEndList();
+  listedBuildings = cityscape.empty() ? NULL : &cityscape[0];
+  listedCount = cityscape.size();
+}
+
+void drawSceneryShader(const std::vector<Building> &cityscape,
+                       int windowWidth, int windowHeight, int timeMs,
+                       int windowStride) {
+  float aspect = (float)windowWidth / (float)windowHeight;
+  float worldLeft = -1.0f, worldRight = 1.0f, worldTop = 1.0f,
+        worldBottom = -1.0f;
+  if (aspect > 1.0f) {
+    worldLeft = -aspect;
+    worldRight = aspect;
+  } else {
+    worldTop = 1.0f / aspect;
+    worldBottom = -1.0f / aspect;
+  }
+
+  glDisable(GL_BLEND);
+
+  // Céu e chão numa passada só
+  useProgram(skyProgram);
+  uniform1f(skyTopUniform, worldTop);
+  glBegin(GL_QUADS);
+  glVertex2f(worldLeft, worldBottom);
+  glVertex2f(worldRight, worldBottom);
+  glVertex2f(worldRight, worldTop);
+  glVertex2f(worldLeft, worldTop);
+  glEnd();
+
+  // Prédios na ordem das camadas; as janelas saem do fragment shader
+  if (listedBuildings != (cityscape.empty() ? NULL : &cityscape[0]) ||
+      listedCount != cityscape.size()) {
+    buildList(cityscape);
+  }
+  useProgram(buildingProgram);
+  uniform1f(flickerUniform, (timeMs / 1000.0f) * 0.2f);
+  uniform1f(strideUniform, static_cast<float>(windowStride));
+  glCallList(buildingList);
+
+  useProgram(0);
+  glEnable(GL_BLEND); // O resto do jogo desenha sempre com blend
+}
@@ -0,0 +1,24 @@
+#ifndef SCENERY_SHADER_H
+#define SCENERY_SHADER_H
+
+#include "GameObjects.h"
+#include <vector>
+
+// Caminho opcional do cenário em GLSL 1.20. Um quad da tela inteira
+// desenha céu e chão; cada prédio é um quad cujo fragment shader gera as
+// janelas a partir dos parâmetros do prédio e do tempo (uniform), com a
+// mesma regra de pisca do caminho da CPU. Os quads ficam numa display
+// list montada uma vez, então o custo de CPU por frame é constante.
+
+// Compila os shaders (precisa do contexto do GL). Sem GL 2.0 ou com erro
+// de compilação devolve false e o cenário segue pela RenderQueue.
+bool initSceneryShader();
+bool sceneryShaderReady();
+
+// Desenha na hora (não enfileira): o cenário é o fundo de tudo, então o
+// que a fila desenhar depois fica por cima
+void drawSceneryShader(const std::vector<Building> &cityscape,
+                       int windowWidth, int windowHeight, int timeMs,
+                       int windowStride);
+
+#endif // SCENERY_SHADER_H
@@ -1,33 +1,48 @@
 #include "Screens.h"
+#include "FrameArena.h"
 #include "GameConstants.h"
-#include "GameState.h"
+#include "GlStats.h"
+#include "MemoryStats.h"
+#include "RenderQueue.h"
+#include "Scenery.h"
 #include "TextRenderer.h"
 #include <GL/glut.h>
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 
-void drawHomeScreen(const std::vector<PlayerScore> &ranking,
+// Retângulo translúcido sobre a tela inteira
+static void queueScreenOverlay(RenderQueue &queue, RenderLayer layer, float r,
+                               float g, float b, float a) {
+  queue.setLayer(layer);
+  queue.color(r, g, b, a);
+  queue.begin(GL_QUADS);
+  queue.vertex(-2.f, -2.f);
+  queue.vertex(2.f, -2.f);
+  queue.vertex(2.f, 2.f);
+  queue.vertex(-2.f, 2.f);
+  queue.end();
+}
+
+void drawHomeScreen(RenderQueue &queue,
+                    const std::vector<PlayerScore> &ranking,
                     const std::string &currentPlayerName,
                     const Button &homeButton,
                     const std::vector<TrashParticle> &homeScreenDebris,
-                    float homeScreenAnimationTimer) {
-  // Desenha os detritos flutuantes no fundo
+                    float homeScreenAnimationTimer, bool assetsLoading,
+                    float assetLoadProgress, const LodContext &lod) {
+  // Desenha os detritos flutuantes no fundo (atrás do overlay de 70%)
+  const float overlayAlpha = 0.7f;
+  queue.setLayer(LAYER_PARTICLES);
   for (const auto &p : homeScreenDebris) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(1.0f, 1.0f, 1.0f, 0.2f);
-    drawRainObject(p);
+    drawRainObject(queue, p,
+                   selectWasteLod(p.size, 1.0f - overlayAlpha, lod));
   }
 
-  // Overlay escuro
-  glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-  glBegin(GL_QUADS);
-  glVertex2f(-2.f, -2.f);
-  glVertex2f(2.f, -2.f);
-  glVertex2f(2.f, 2.f);
-  glVertex2f(-2.f, 2.f);
-  glEnd();
+  // Overlay escuro; o cenário e os detritos saem aqui, o resto da tela é
+  // texto e interface em modo imediato
+  queueScreenOverlay(queue, LAYER_OVERLAY, 0.0f, 0.0f, 0.0f, overlayAlpha);
+  queue.flush();
 
   // Animação dos elementos da UI
   float animProgress =
@@ -70,14 +85,12 @@ void drawHomeScreen(const std::vector<PlayerScore> &ranking,
   glVertex2f(-boxWidth / 2, boxY + boxHeight / 2);
   glEnd();
 
-  // Texto do nome com cursor
-  std::string nameWithCursor = currentPlayerName;
-  if (glutGet(GLUT_ELAPSED_TIME) % 1000 < 500) {
-    nameWithCursor += "_";
-  }
+  // Texto do nome com cursor (string do frame, sem alocar)
+  const char *nameWithCursor = frameArena().format(
+      "%s%s", currentPlayerName.c_str(),
+      glutGet(GLUT_ELAPSED_TIME) % 1000 < 500 ? "_" : "");
   glColor4f(1.0f, 1.0f, 1.0f, contentAlpha);
-  renderStrokeText(0.0f, 0.06f, 0.0004f, 2.0f, nameWithCursor.c_str(),
-                   ALIGN_CENTER);
+  renderStrokeText(0.0f, 0.06f, 0.0004f, 2.0f, nameWithCursor, ALIGN_CENTER);
 
   // Botão Iniciar
   glPushMatrix();
@@ -112,17 +125,37 @@ void drawHomeScreen(const std::vector<PlayerScore> &ranking,
     renderStrokeText(0.0f, currentY, 0.00025f, 1.0f,
                      "Nenhuma pontuacao registrada.", ALIGN_CENTER);
   }
+
+  // Indicador de carregamento do áudio
+  if (assetsLoading) {
+    float barWidth = 0.6f, barY = -0.88f;
+    glColor4f(0.8f, 0.8f, 0.8f, contentAlpha);
+    renderStrokeText(0.0f, barY + 0.03f, 0.00022f, 1.0f, "Carregando audio...",
+                     ALIGN_CENTER);
+
+    glColor4f(0.3f, 0.3f, 0.3f, contentAlpha);
+    glBegin(GL_QUADS);
+    glVertex2f(-barWidth / 2, barY - 0.01f);
+    glVertex2f(barWidth / 2, barY - 0.01f);
+    glVertex2f(barWidth / 2, barY);
+    glVertex2f(-barWidth / 2, barY);
+    glEnd();
+
+    glColor4f(0.0f, 1.0f, 0.0f, contentAlpha);
+    glBegin(GL_QUADS);
+    glVertex2f(-barWidth / 2, barY - 0.01f);
+    glVertex2f(-barWidth / 2 + barWidth * assetLoadProgress, barY - 0.01f);
+    glVertex2f(-barWidth / 2 + barWidth * assetLoadProgress, barY);
+    glVertex2f(-barWidth / 2, barY);
+    glEnd();
+  }
 }
 
-void drawPauseMenu(const std::vector<Button> &pauseButtons) {
-  // Overlay escuro
-  glColor4f(0.0f, 0.0f, 0.0f, 0.8f);
-  glBegin(GL_QUADS);
-  glVertex2f(-2.f, -2.f);
-  glVertex2f(2.f, -2.f);
-  glVertex2f(2.f, 2.f);
-  glVertex2f(-2.f, 2.f);
-  glEnd();
+void drawPauseMenu(RenderQueue &queue,
+                   const std::vector<Button> &pauseButtons) {
+  // Overlay escuro (por cima do HUD, que já foi desenhado)
+  queueScreenOverlay(queue, LAYER_OVERLAY, 0.0f, 0.0f, 0.0f, 0.8f);
+  queue.flush();
 
   // Título PAUSADO
   glColor3f(1.0f, 1.0f, 1.0f);
@@ -134,27 +167,42 @@ void drawPauseMenu(const std::vector<Button> &pauseButtons) {
   }
 }
 
-void drawGamePlayScreen(const std::vector<FallingObject> &objects,
-                        const Basket &basket, int score, int misses) {
+void drawGamePlayScreen(RenderQueue &queue,
+                        const std::vector<FallingObject> &objects,
+                        const Basket &basket,
+                        const std::vector<Basket> &extraBaskets, int score,
+                        int misses, bool stress, int difficultyLevel,
+                        int scoreForNextLevel, const LodContext &lod) {
   // Blur no fundo
-  glColor4f(0.1f, 0.1f, 0.1f, 0.45f);
-  glBegin(GL_QUADS);
-  glVertex2f(-2.f, -2.f);
-  glVertex2f(2.f, -2.f);
-  glVertex2f(2.f, 2.f);
-  glVertex2f(-2.f, 2.f);
-  glEnd();
+  queueScreenOverlay(queue, LAYER_SCENERY_SHADE, 0.1f, 0.1f, 0.1f, 0.45f);
+
+  // Desenha objetos. Todos têm o mesmo tamanho, e o tipo precisa ficar
+  // legível: o governador de qualidade não reduz o detalhe aqui.
+  if (!objects.empty()) {
+    LodContext objectLod = lod;
+    objectLod.bias = 0;
+    WasteLod objectDetail = selectWasteLod(objects[0].size, 1.0f, objectLod);
+    queue.setLayer(LAYER_OBJECTS);
+    for (const auto &obj : objects) {
+      const_cast<FallingObject &>(obj).draw(queue, objectDetail);
+    }
+  }
 
-  // Desenha objetos
-  for (const auto &obj : objects) {
-    const_cast<FallingObject &>(obj).draw();
+  // Cestas automáticas do modo stress
+  queue.setLayer(LAYER_BASKETS);
+  for (const auto &extra : extraBaskets) {
+    queue.pushMatrix();
+    queue.translate(extra.x, extra.y);
+    const_cast<Basket &>(extra).draw(queue);
+    queue.popMatrix();
   }
 
   // Desenha cesta
-  glPushMatrix();
-  glTranslatef(basket.x, basket.y, 0.0f);
-  const_cast<Basket &>(basket).draw();
-  glPopMatrix();
+  queue.pushMatrix();
+  queue.translate(basket.x, basket.y);
+  const_cast<Basket &>(basket).draw(queue);
+  queue.popMatrix();
+  queue.flush();
 
   // HUD
   char scoreText[50];
@@ -163,7 +211,12 @@ void drawGamePlayScreen(const std::vector<FallingObject> &objects,
   renderBitmapText(-0.95f, 0.9f, GLUT_BITMAP_HELVETICA_18, scoreText);
 
   char missesText[50];
-  sprintf(missesText, "Erros: %d/%d", misses, MAX_MISSES);
+  if (stress) {
+    sprintf(missesText, "Erros: %d (stress: %d objetos)", misses,
+            static_cast<int>(objects.size()));
+  } else {
+    sprintf(missesText, "Erros: %d/%d", misses, MAX_MISSES);
+  }
   glColor3f(1.0f, 0.5f, 0.5f);
   renderBitmapText(-0.95f, 0.85f, GLUT_BITMAP_HELVETICA_18, missesText);
 
@@ -198,12 +251,12 @@ void drawGamePlayScreen(const std::vector<FallingObject> &objects,
 
   // Indicador de nível de dificuldade
   char levelText[50];
-  sprintf(levelText, "Nivel: %d", getDifficultyLevel());
+  sprintf(levelText, "Nivel: %d", difficultyLevel);
   glColor3f(1.0f, 1.0f, 0.0f);
   renderBitmapText(-0.95f, 0.75f, GLUT_BITMAP_HELVETICA_18, levelText);
 
   // Barra de progresso para próximo nível (opcional)
-  float progress = static_cast<float>(score) / scoreForNextDifficultyIncrease;
+  float progress = static_cast<float>(score) / scoreForNextLevel;
   if (progress > 1.0f)
     progress = 1.0f;
 
@@ -226,36 +279,41 @@ void drawGamePlayScreen(const std::vector<FallingObject> &objects,
   renderBitmapText(0.6f, 0.9f, GLUT_BITMAP_HELVETICA_18, "'P' para Pausar");
 }
 
-void drawGameOverScreen(const std::vector<TrashParticle> &trashRain,
+void drawGameOverScreen(RenderQueue &queue,
+                        const std::vector<TrashParticle> &trashRain,
+                        const std::vector<SettledParticle> &settledRain,
                         const Basket &basket, float gameOverBasketY,
                         float gameOverBasketAngle, float gameOverAnimationTimer,
                         int displayedScore,
                         const std::vector<PlayerScore> &ranking,
                         const std::string &currentPlayerName,
-                        int finalScoreHolder) {
+                        int finalScoreHolder, const LodContext &lod) {
   float animProgress =
       std::min(1.0f, gameOverAnimationTimer / GAMEOVER_ANIMATION_DURATION);
+  float overlayAlpha = 0.8f * animProgress;
 
-  // Chuva de lixo
+  // Chuva de lixo: a pilha embaixo das que ainda caem
+  queue.setLayer(LAYER_PARTICLES);
+  for (const auto &p : settledRain) {
+    drawSettledParticle(queue, p,
+                        selectWasteLod(p.getSize(), 1.0f - overlayAlpha, lod));
+  }
   for (const auto &p : trashRain) {
-    drawRainObject(p);
+    drawRainObject(queue, p,
+                   selectWasteLod(p.size, 1.0f - overlayAlpha, lod));
   }
 
   // Cesta caindo
-  glPushMatrix();
-  glTranslatef(basket.x, gameOverBasketY, 0.0f);
-  glRotatef(gameOverBasketAngle, 0.0f, 0.0f, 1.0f);
-  const_cast<Basket &>(basket).draw();
-  glPopMatrix();
+  queue.setLayer(LAYER_BASKETS);
+  queue.pushMatrix();
+  queue.translate(basket.x, gameOverBasketY);
+  queue.rotate(gameOverBasketAngle);
+  const_cast<Basket &>(basket).draw(queue);
+  queue.popMatrix();
 
   // Overlay escuro
-  glColor4f(0.0f, 0.0f, 0.0f, 0.8f * animProgress);
-  glBegin(GL_QUADS);
-  glVertex2f(-2.f, -2.f);
-  glVertex2f(2.f, -2.f);
-  glVertex2f(2.f, 2.f);
-  glVertex2f(-2.f, 2.f);
-  glEnd();
+  queueScreenOverlay(queue, LAYER_OVERLAY, 0.0f, 0.0f, 0.0f, overlayAlpha);
+  queue.flush();
 
   // Texto só aparece após 70% da animação
   if (animProgress > 0.7f) {
@@ -320,3 +378,104 @@ void drawGameOverScreen(const std::vector<TrashParticle> &trashRain,
     }
   }
 }
+
+void drawFrame(RenderQueue &queue, const RenderSnapshot &s,
+               const std::vector<Building> &cityscape, int windowWidth,
+               int windowHeight, const QualitySettings &quality) {
+  // A projeção mostra 2 unidades no lado menor da janela
+  LodContext lod;
+  lod.pixelsPerUnit = std::min(windowWidth, windowHeight) / 2.0f;
+  lod.bias = quality.particleLodBias;
+
+  glClear(GL_COLOR_BUFFER_BIT);
+  queue.beginFrame();
+  queue.setPixelSize(1.0f / lod.pixelsPerUnit);
+  drawUrbanScenery(queue, cityscape, windowWidth, windowHeight,
+                   quality.windowStride);
+
+  switch (s.gameState) {
+  case STATE_HOME:
+    drawHomeScreen(queue, s.ranking, s.currentPlayerName, s.homeButton,
+                   s.homeScreenDebris, s.homeScreenAnimationTimer,
+                   s.assetsLoading, s.assetLoadProgress, lod);
+    break;
+  case STATE_PLAYING:
+    drawGamePlayScreen(queue, s.objects, s.basket, s.extraBaskets, s.score,
+                       s.misses, s.stress, s.difficultyLevel,
+                       s.scoreForNextLevel, lod);
+    break;
+  case STATE_PAUSED:
+    drawGamePlayScreen(queue, s.objects, s.basket, s.extraBaskets, s.score,
+                       s.misses, s.stress, s.difficultyLevel,
+                       s.scoreForNextLevel, lod);
+    drawPauseMenu(queue, s.pauseButtons);
+    break;
+  case STATE_GAMEOVER:
+    drawGameOverScreen(queue, s.trashRain, s.settledRain, s.basket,
+                       s.gameOverBasketY, s.gameOverBasketAngle,
+                       s.gameOverAnimationTimer, s.displayedScore, s.ranking,
+                       s.currentPlayerName, s.finalScoreHolder, lod);
+    break;
+  }
+}
+
+void drawProfilerOverlay(const FrameStats &stats, const char *qualityName,
+                         bool adaptiveQuality,
+                         const RenderQueueStats &queueStats,
+                         const GlCallCounts *glCounts) {
+  float top = glCounts ? -0.48f : -0.58f;
+  glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+  glBegin(GL_QUADS);
+  glVertex2f(-0.97f, -0.97f);
+  glVertex2f(-0.02f, -0.97f);
+  glVertex2f(-0.02f, top);
+  glVertex2f(-0.97f, top);
+  glEnd();
+
+  char line[100];
+  glColor3f(0.6f, 1.0f, 0.6f);
+  float y = top;
+  if (glCounts) {
+    sprintf(line, "gl: %ld chamadas, %ld primitivas, %ld vertices, %.1f KB",
+            glCounts->calls, glCounts->primitives, glCounts->vertices,
+            glCounts->uploadBytes / 1024.0);
+    renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+    sprintf(line, "gl: %ld cores, %ld estado, %ld matriz, %ld caracteres",
+            glCounts->colors, glCounts->stateChanges, glCounts->matrixOps,
+            glCounts->textChars);
+    renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+  }
+
+  // Memória por subsistema em KB, vivo/pico (MemoryStats), três por linha
+  int length = sprintf(line, "mem: total %.0f/%.0f",
+                       memoryStatsTotalLive() / 1024.0,
+                       memoryStatsTotalPeak() / 1024.0);
+  int items = 1;
+  for (int c = 0; c < MEMORY_CATEGORY_COUNT; ++c, ++items) {
+    if (items == 3) {
+      renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+      length = sprintf(line, "mem:");
+      items = 0;
+    }
+    MemoryCategory category = static_cast<MemoryCategory>(c);
+    length += snprintf(line + length, sizeof(line) - length, " %s %.0f/%.0f",
+                       memoryCategoryName(category),
+                       memoryStatsLive(category) / 1024.0,
+                       memoryStatsPeak(category) / 1024.0);
+  }
+  renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+
+  sprintf(line, "fila: %d primitivas -> %d draws, %d trocas de estado",
+          queueStats.primitives, queueStats.drawCalls,
+          queueStats.stateChanges);
+  renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+  sprintf(line, "%.0f fps | frame %.1f ms | %.0f%% atrasados", stats.fps,
+          stats.frameMs, stats.lateFraction * 100.0);
+  renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+  sprintf(line, "desenho %.2f ms | tick %.2f ms", stats.renderMs,
+          stats.tickMs);
+  renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+  sprintf(line, "qualidade %s (%s)", qualityName,
+          adaptiveQuality ? "auto" : "fixa");
+  renderBitmapText(-0.95f, y -= 0.05f, GLUT_BITMAP_HELVETICA_12, line);
+}
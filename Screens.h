@@ -2,26 +2,56 @@
 #define SCREENS_H
 
 #include "GameObjects.h"
+#include "QualityGovernor.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
 #include <vector>
 
-// Funções para desenhar as diferentes telas
-void drawHomeScreen(const std::vector<PlayerScore> &ranking,
+struct GlCallCounts;
+
+// Funções para desenhar as diferentes telas. Cada uma enfileira sua
+// geometria na fila (que já traz o cenário), faz o flush e desenha texto e
+// botões por cima em modo imediato.
+void drawHomeScreen(RenderQueue &queue,
+                    const std::vector<PlayerScore> &ranking,
                     const std::string &currentPlayerName,
                     const Button &homeButton,
                     const std::vector<TrashParticle> &homeScreenDebris,
-                    float homeScreenAnimationTimer);
+                    float homeScreenAnimationTimer, bool assetsLoading,
+                    float assetLoadProgress, const LodContext &lod);
 
-void drawPauseMenu(const std::vector<Button> &pauseButtons);
+void drawPauseMenu(RenderQueue &queue,
+                   const std::vector<Button> &pauseButtons);
 
-void drawGamePlayScreen(const std::vector<FallingObject> &objects,
-                        const Basket &basket, int score, int misses);
+void drawGamePlayScreen(RenderQueue &queue,
+                        const std::vector<FallingObject> &objects,
+                        const Basket &basket,
+                        const std::vector<Basket> &extraBaskets, int score,
+                        int misses, bool stress, int difficultyLevel,
+                        int scoreForNextLevel, const LodContext &lod);
 
-void drawGameOverScreen(const std::vector<TrashParticle> &trashRain,
+void drawGameOverScreen(RenderQueue &queue,
+                        const std::vector<TrashParticle> &trashRain,
+                        const std::vector<SettledParticle> &settledRain,
                         const Basket &basket, float gameOverBasketY,
                         float gameOverBasketAngle, float gameOverAnimationTimer,
                         int displayedScore,
                         const std::vector<PlayerScore> &ranking,
                         const std::string &currentPlayerName,
-                        int finalScoreHolder);
+                        int finalScoreHolder, const LodContext &lod);
+
+// Frame completo de um snapshot: cenário e tela atual, sem o overlay do F3.
+// display() e o renderizador offscreen desenham por aqui.
+void drawFrame(RenderQueue &queue, const RenderSnapshot &s,
+               const std::vector<Building> &cityscape, int windowWidth,
+               int windowHeight, const QualitySettings &quality);
+
+// Tempos do último segundo, nível de qualidade, contadores da fila e
+// memória por subsistema (F3); glCounts (build com GLSTATS=1) acrescenta as
+// chamadas de GL do frame
+void drawProfilerOverlay(const FrameStats &stats, const char *qualityName,
+                         bool adaptiveQuality,
+                         const RenderQueueStats &queueStats,
+                         const GlCallCounts *glCounts);
 
 #endif // SCREENS_H
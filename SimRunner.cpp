@@ -0,0 +1,179 @@
+// Roda a thread de simulação do jogo sem janela, pelo mesmo caminho do
+// jogo: entrada pela fila, simulationStep (simulação, eventos, efeitos,
+// histórico do rewind, autosave) e publicação do snapshot, lido aqui como
+// o display() leria. Um roteiro fixo passa pela tela inicial, por uma
+// partida do AutoplayBot com rewind, pelo game over (ranking, música e
+// chuva de lixo, também com rewind) e pelo recomeço.
+//
+// Compilado com make ALLOCSTATS=1, falha se algum passo estável alocar
+// memória. Sem placa de som, rode com SDL_AUDIODRIVER=dummy; sem áudio o
+// roteiro roda do mesmo jeito, só sem os efeitos.
+//
+// O ranking e o autosave vão para um diretório temporário, apagado no fim.
+//
+// Uso: ./simrunner [--play SEGUNDOS] [--gameover SEGUNDOS] [--alloc-trap]
+#include "AllocStats.h"
+#include "AudioManager.h"
+#include "GameState.h"
+#include "MemoryStats.h"
+#include "RankingSystem.h"
+#include "SimulationThread.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+// Custo médio do passo em cada estado, pelo tickMs dos snapshots
+struct StepCost {
+  double sumMs;
+  long samples;
+};
+static StepCost stepCost[STATE_GAMEOVER + 1];
+
+static void sendKey(InputCommandType type, int key) {
+  InputCommand command;
+  command.type = type;
+  command.key = key;
+  command.x = command.y = 0.0f;
+  pushInputCommand(command);
+}
+
+// Lê os snapshots a ~60 Hz, como a thread do GLUT, por seconds segundos ou
+// até o estado until (-1: só o tempo)
+static bool runFor(double seconds, int until) {
+  Clock::time_point end = Clock::now() + std::chrono::milliseconds(
+                                             static_cast<int>(seconds * 1000));
+  while (Clock::now() < end) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    const RenderSnapshot &s = acquireLatestSnapshot();
+    stepCost[s.gameState].sumMs += s.tickMs;
+    stepCost[s.gameState].samples++;
+    if (s.gameState == until) {
+      return true;
+    }
+  }
+  return until < 0;
+}
+
+// Segura Backspace (volta no tempo) por seconds segundos
+static void holdRewind(double seconds) {
+  sendKey(INPUT_KEY, 8);
+  runFor(seconds, -1);
+  sendKey(INPUT_KEY_UP, 8);
+}
+
+// Mesmo áudio do jogo (main.cpp), carregado antes da simulação começar
+static void initAudio() {
+  if (!audioManager.initialize()) {
+    printf("Aviso: sem áudio, o roteiro roda sem os efeitos\n");
+    return;
+  }
+  audioManager.openAssetPack(AUDIO_PACK);
+  audioManager.queueMusic("menu", MUSIC_MENU);
+  audioManager.queueMusic("gameover", MUSIC_GAMEOVER);
+  audioManager.configureSound("button_click", 3, 2);
+  audioManager.configureSound("collect_wrong", 2, 3);
+  audioManager.configureSound("collect_correct", 1, 3);
+  audioManager.queueSound("collect_correct", SOUND_COLLECT_CORRECT);
+  audioManager.queueSound("collect_wrong", SOUND_COLLECT_WRONG);
+  audioManager.queueSound("button_click", SOUND_BUTTON_CLICK);
+  audioManager.startAsyncLoading();
+  audioManager.playMusic("menu");
+
+  // Os arquivos soltos são lidos pelo caminho relativo: termina de ler
+  // antes de trocar de diretório
+  for (int i = 0; i < 1000 && audioManager.isLoading(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+int main(int argc, char **argv) {
+  double playSeconds = 12.0, gameOverSeconds = 8.0;
+  bool valid = true;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--alloc-trap") == 0) {
+      allocStatsSetTrap(true); // Aborta na primeira alocação indevida
+    } else if (strcmp(argv[i], "--play") == 0 && i + 1 < argc) {
+      playSeconds = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--gameover") == 0 && i + 1 < argc) {
+      gameOverSeconds = atof(argv[++i]);
+    } else {
+      valid = false;
+    }
+  }
+  if (!valid || playSeconds <= 0.0 || gameOverSeconds <= 0.0) {
+    fprintf(stderr,
+            "Uso: %s [--play SEGUNDOS] [--gameover SEGUNDOS] "
+            "[--alloc-trap]\n",
+            argv[0]);
+    return 1;
+  }
+
+  initAudio();
+  char dir[] = "/tmp/simrunner.XXXXXX";
+  if (mkdtemp(dir) == NULL || chdir(dir) != 0) {
+    fprintf(stderr, "Erro: nao foi possivel criar o diretorio temporario\n");
+    return 1;
+  }
+
+  initHomeScreen();
+  loadRanking(ranking);
+  setAutoplay(true);
+  startSimulationThread();
+
+  // Tela inicial: nome do jogador e Enter
+  bool ok = runFor(1.0, -1);
+  const char *name = "simrunner";
+  for (const char *c = name; *c; ++c) {
+    sendKey(INPUT_KEY, *c);
+  }
+  sendKey(INPUT_KEY, 13);
+  ok = ok && runFor(2.0, STATE_PLAYING);
+
+  // Partida do bot (com autosaves) e um trecho de rewind
+  ok = ok && runFor(playSeconds, -1);
+  holdRewind(1.0);
+  ok = ok && runFor(2.0, -1);
+
+  // Sem o bot a cesta fica parada e os erros terminam a partida
+  setAutoplay(false);
+  bool reachedGameOver = runFor(120.0, STATE_GAMEOVER);
+  ok = ok && reachedGameOver && runFor(gameOverSeconds, -1);
+  holdRewind(1.0);
+
+  // Recomeça
+  setAutoplay(true);
+  sendKey(INPUT_KEY, 'r');
+  ok = ok && runFor(2.0, STATE_PLAYING) && runFor(3.0, -1);
+  stopSimulationThread();
+  audioManager.cleanup();
+
+  remove(RANKING_FILENAME.c_str());
+  remove(SAVEGAME_FILENAME.c_str());
+  remove((SAVEGAME_FILENAME + ".tmp").c_str());
+  if (chdir("/") != 0 || rmdir(dir) != 0) {
+    fprintf(stderr, "Aviso: %s nao foi removido\n", dir);
+  }
+
+  static const char *stateNames[] = {"inicio", "jogo", "pausa", "fim"};
+  for (int s = 0; s <= STATE_GAMEOVER; ++s) {
+    if (stepCost[s].samples > 0) {
+      printf("%-7s passo medio %.3f ms (%ld snapshots)\n", stateNames[s],
+             stepCost[s].sumMs / stepCost[s].samples, stepCost[s].samples);
+    }
+  }
+  if (!ok) {
+    fprintf(stderr, "Erro: o roteiro nao passou por %s\n",
+            reachedGameOver ? "todas as telas" : "game over");
+  }
+  memoryStatsReport();
+  if (allocStatsEnabled()) {
+    allocStatsReport();
+    return !ok || allocStatsViolations() > 0 ? 1 : 0;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Entra no game over; salvar o ranking e trocar a música ficam com os
+// consumidores do evento
+static void enterGameOver(World &w) {
+  w.gameOver = true;
+  w.finalScoreHolder = w.score;
+  w.gameOverBasketY = w.basket.y;
+  w.events.push(EVENT_GAME_OVER, PAPER, w.score);
+}
+
+// Conta um erro; no modo stress os erros não terminam a partida nem geram
+// eventos (seriam centenas por tick). Num passo de vários ticks mais de um
+// objeto pode chegar ao chão: depois do game over os outros não contam, para
+// o fim da partida ser anunciado uma vez só
+static void countMiss(World &w, GameEventType type, WASTE_TYPE wasteType) {
+  if (w.gameOver) {
+    return;
+  }
+  w.misses++;
+  if (w.isStress()) {
+    return;
+  }
+  w.events.push(type, wasteType, w.misses);
+  if (w.misses >= MAX_MISSES) {
+    enterGameOver(w);
+  }
+}
+
+// Restringe [t0, t1] aos instantes em que p + v * t fica em [lo, hi]
+static bool clipSlab(float p, float v, float lo, float hi, float &t0,
+                     float &t1) {
+  if (v == 0.0f) {
+    return p >= lo && p <= hi;
+  }
+  float ta = (lo - p) / v, tb = (hi - p) / v;
+  if (ta > tb) {
+    std::swap(ta, tb);
+  }
+  t0 = std::max(t0, ta);
+  t1 = std::min(t1, tb);
+  return t0 <= t1;
+}
+
+// Colisão contínua (swept AABB) no referencial da cesta: durante o passo o
+// objeto desce de y0 a y1 e a cesta anda de bx0 a bx1. Há coleta se em
+// algum instante o centro do objeto está entre o meio da cesta e o ponto
+// em que encosta na borda de cima, sobrepondo a cesta em x. Com passos
+// grandes (tick lento ou recuperação depois de um engasgo) o objeto não
+// atravessa a cesta sem ser pego.
+static bool sweptCatch(const FallingObject &obj, float y0, float y1,
+                       const Basket &basket, float bx0, float bx1) {
+  float t0 = 0.0f, t1 = 1.0f;
+  float bandLow = basket.y;
+  float bandHigh = basket.y + basket.height / 2 + obj.size * 0.5f;
+  if (!clipSlab(y0, y1 - y0, bandLow, bandHigh, t0, t1)) {
+    return false;
+  }
+  float reach = obj.size / 2 + basket.width / 2;
+  return clipSlab(obj.x - bx0, -(bx1 - bx0), -reach, reach, t0, t1);
+}
+
+// Cesta automática do modo stress que pega o objeto, se houver (são
+// poucas; o filtro de altura já eliminou quase todos os objetos)
+static const Basket *findExtraBasket(const World &w, const FallingObject &obj,
+                                     float y0, float previousTime) {
+  for (size_t b = 0; b < w.extraBaskets.size(); ++b) {
+    const Basket &basket = w.extraBaskets[b];
+    if (sweptCatch(obj, y0, obj.y, basket, w.extraBasketX(b, previousTime),
+                   basket.x)) {
+      return &basket;
+    }
+  }
+  return nullptr;
+}
+
+static void updatePlaying(World &w, float dt) {
+  std::vector<FallingObject> &objects = w.objects;
+  const Basket &basket = w.basket;
+  float previousTime = w.time;
+  w.time += dt;
+
+  // Velocidades são por tick nominal; um passo maior (tick lento ou
+  // recuperação de engasgo) anda o equivalente a vários ticks
+  const float steps = dt / (SIMULATION_TICK_MS / 1000.0f);
+  const int wholeSteps = std::max(1, static_cast<int>(steps + 0.5f));
+
+  // Movimento da cesta
+  float basketStartX = basket.x;
+  if (w.moveLeft && !w.moveRight) {
+    w.basket.move(-steps, w.difficultyMultiplier);
+  } else if (w.moveRight && !w.moveLeft) {
+    w.basket.move(steps, w.difficultyMultiplier);
+  }
+  w.placeExtraBaskets();
+
+  // Sistema de spawn controlado por timer; o modo stress enche a tela em
+  // STRESS_FILL_TICKS ticks
+  w.spawnTimer += wholeSteps;
+  if (w.isStress()) {
+    int spawns =
+        std::max(1, w.stress.objectCount / STRESS_FILL_TICKS) * wholeSteps;
+    for (int k = 0; k < spawns && objects.size() <
+                                      static_cast<size_t>(w.stress.objectCount);
+         ++k) {
+      objects.push_back(FallingObject(w));
+    }
+  } else if (w.spawnTimer >= w.spawnDelay &&
+             objects.size() <
+                 static_cast<size_t>(w.difficulty.maxNumObjects)) {
+    objects.push_back(FallingObject(w));
+    w.spawnTimer = 0;
+  }
+
+  // Atualiza objetos em ordem de spawn. Os que saem da tela (coletados ou
+  // perdidos) são retirados do vetor sem mudar a ordem dos outros e
+  // renascem no fim, como os mais novos. A ordem vale para todos os
+  // objetos no jogo normal e por faixa no modo stress.
+  std::vector<FallingObject> &finished = w.finishedObjects;
+  std::vector<int> &laneTail = w.laneTail;
+  finished.clear();
+  laneTail.assign(w.isStress() ? w.laneCount() : 1, -1);
+  float basket_top = basket.y + basket.height / 2;
+  size_t kept = 0;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    FallingObject &obj = objects[i];
+    int &tail = laneTail[w.isStress() ? obj.lane % laneTail.size() : 0];
+    float startY = obj.y;
+    obj.update(tail >= 0 ? &objects[tail] : nullptr, steps);
+
+    // Todas as cestas estão na mesma altura: só os objetos que passaram
+    // por essa faixa durante o passo testam colisão
+    float obj_bottom = obj.y - obj.size * 0.5f;
+    bool crossedBasketHeight =
+        std::min(startY, obj.y) - obj.size * 0.5f <= basket_top &&
+        std::max(startY, obj.y) >= basket.y;
+
+    // Verifica colisão com a cesta (antes do chão: num passo grande o
+    // objeto pode passar pela cesta e chegar ao chão)
+    if (crossedBasketHeight &&
+        sweptCatch(obj, startY, obj.y, basket, basketStartX, basket.x)) {
+      if (obj.wasteType == basket.wasteType) {
+        w.score++;
+        w.events.push(EVENT_COLLECT_CORRECT, obj.wasteType, w.score);
+      } else {
+        countMiss(w, EVENT_COLLECT_WRONG, obj.wasteType);
+      }
+      finished.push_back(obj);
+
+      // Atualiza sistema de dificuldade
+      updateDifficulty(w);
+    }
+    // Cestas automáticas: só retiram o objeto, sem pontos nem erros
+    else if (crossedBasketHeight && !w.extraBaskets.empty() &&
+             findExtraBasket(w, obj, startY, previousTime) != nullptr) {
+      finished.push_back(obj);
+    }
+    // Verifica se caiu no chão
+    else if (obj_bottom < -0.8f) {
+      countMiss(w, EVENT_MISS, obj.wasteType);
+      finished.push_back(obj);
+    } else {
+      if (kept != i) {
+        objects[kept] = obj;
+      }
+      tail = static_cast<int>(kept);
+      kept++;
+    }
+  }
+
+  objects.erase(objects.begin() + kept, objects.end());
+  for (size_t i = 0; i < finished.size(); ++i) {
+    finished[i].respawn(w);
+    objects.push_back(finished[i]);
+  }
+}
+
+// Empurra p para fora de outra partícula de largura width em (x, y);
+// devolve true se p ficou apoiada nela
+static bool collideRainParticle(TrashParticle &p, float x, float y,
+                                float width, float dt) {
+  float dist_x = p.x - x, dist_y = p.y - y;
+  float raios_soma = (p.largura + width) / 2.0f;
+  float dist_sq = dist_x * dist_x + dist_y * dist_y;
+  if (dist_sq >= raios_soma * raios_soma) {
+    return false; // Quase todos os pares: sem a raiz
+  }
+
+  float dist_total = sqrt(dist_sq);
+  if (dist_total < raios_soma) {
+    float overlap = raios_soma - dist_total;
+    p.x += (overlap * (p.x - x)) / dist_total;
+    p.y += (overlap * (p.y - y)) / dist_total;
+    p.vx += (dist_x > 0 ? 1 : -1) * 0.05f * dt;
+    return p.y > y;
+  }
+  return false;
+}
+
+static void updateGameOver(World &w, float dt) {
+  std::vector<TrashParticle> &trashRain = w.trashRain;
+  const std::vector<SettledParticle> &settledRain = w.settledRain;
+  const Basket &basket = w.basket;
+
+  // Animação de game over
+  if (w.gameOverAnimationTimer < GAMEOVER_ANIMATION_DURATION) {
+    w.gameOverAnimationTimer += dt;
+  }
+
+  // Animação de contagem da pontuação
+  if (w.displayedScore < w.finalScoreHolder) {
+    int increment = std::max(1, (w.finalScoreHolder - w.displayedScore) / 15);
+    w.displayedScore =
+        std::min(w.finalScoreHolder, w.displayedScore + increment);
+  }
+
+  // Animação da cesta tombando
+  if (w.gameOverBasketAngle > -90.0f) {
+    w.gameOverBasketAngle -= 2.0f;
+    if (w.gameOverBasketAngle < -90.0f) {
+      w.gameOverBasketAngle = -90.0f;
+    }
+  }
+  float finalY = -0.8f + basket.width / 2.0f;
+  w.gameOverBasketY =
+      basket.y + (finalY - basket.y) * fabs(w.gameOverBasketAngle / -90.0f);
+
+  // Gera partículas de chuva de lixo (por padrão, em média a cada dois
+  // ticks). O limite conta a pilha e as que ainda caem
+  if (w.randomInt(w.rain.emissionOdds) == 0 &&
+      trashRain.size() + settledRain.size() <
+          static_cast<size_t>(w.rain.maxParticles) &&
+      trashRain.size() < static_cast<size_t>(TRASH_RAIN_MAX_FALLING)) {
+    TrashParticle p;
+    p.x = w.randomFloat() * 4.0f - 2.0f;
+    p.y = 1.2f + w.randomFloat() * 0.5f;
+    p.vx = (w.randomFloat() - 0.5f) * 0.5f;
+    p.vy = 0.0f;
+    p.size = 0.06f + w.randomFloat() * 0.05f;
+    p.largura = p.size;
+    p.altura = p.size;
+    p.rotation = static_cast<float>(w.randomInt(360));
+    p.rotationSpeed = (w.randomFloat() - 0.5f) * 4.0f;
+    p.type = static_cast<WASTE_TYPE>(w.randomInt(WASTE_TYPE_COUNT));
+    p.estatico = false;
+    trashRain.push_back(p);
+  }
+
+  // Simulação física das partículas
+  for (size_t i = 0; i < trashRain.size(); ++i) {
+    TrashParticle &p = trashRain[i];
+    if (p.estatico) {
+      continue;
+    }
+
+    p.vy -= 0.0008f;
+    p.x += p.vx * dt;
+    p.y += p.vy;
+    p.rotation += p.rotationSpeed;
+
+    bool emRepouso = false;
+    if (p.y - p.altura / 2.0f <= -0.8f) {
+      p.y = -0.8f + p.altura / 2.0f;
+      emRepouso = true;
+    }
+
+    // Colisão entre partículas: as que caem e depois a pilha
+    for (size_t j = 0; j < trashRain.size(); ++j) {
+      if (i == j)
+        continue;
+
+      const TrashParticle &other = trashRain[j];
+      if (collideRainParticle(p, other.x, other.y, other.largura, dt)) {
+        emRepouso = true;
+      }
+    }
+    // Na pilha, os pares distantes saem pela comparação em ponto fixo,
+    // sem converter a partícula (folga de 2 para o arredondamento)
+    int px = static_cast<int>(lroundf(p.x * SETTLED_POSITION_SCALE));
+    int py = static_cast<int>(lroundf(p.y * SETTLED_POSITION_SCALE));
+    int width = static_cast<int>(lroundf(p.largura * SETTLED_POSITION_SCALE));
+    for (size_t j = 0; j < settledRain.size(); ++j) {
+      const SettledParticle &other = settledRain[j];
+      int reach = (width + other.size * SETTLED_SIZE_TO_POSITION) / 2 + 2;
+      if (abs(px - other.x) >= reach || abs(py - other.y) >= reach) {
+        continue;
+      }
+      if (collideRainParticle(p, other.getX(), other.getY(), other.getSize(),
+                              dt)) {
+        emRepouso = true;
+      }
+      px = static_cast<int>(lroundf(p.x * SETTLED_POSITION_SCALE));
+      py = static_cast<int>(lroundf(p.y * SETTLED_POSITION_SCALE));
+    }
+
+    if (emRepouso) {
+      p.vx *= 0.85f;
+      p.vy = 0;
+      if (fabs(p.vx) < 0.001f) {
+        p.estatico = true;
+        p.vx = 0;
+        p.rotationSpeed = 0;
+      }
+    }
+  }
+
+  // Só depois do laço: as que pararam neste tick ainda colidiram como
+  // partículas completas com as que vieram depois delas
+  w.settleStoppedParticles();
+}
+
+// Funções para gerenciamento de dificuldade
+void updateDifficulty(World &w) {
+  if (w.score >= w.scoreForNextLevel) {
+    w.difficultyLevel++;
+
+    // Calcula multiplicador de dificuldade com curva mais agressiva para 8
+    // níveis
+    w.difficultyMultiplier = 1.0f + (w.difficultyLevel - 1) * 0.4f;
+
+    // Aumenta velocidade gradualmente com progressão mais acentuada
+    const DifficultyParams &params = w.difficulty;
+    float speedBoost =
+        params.speedIncreaseRate * (1.0f + w.difficultyLevel * 0.5f);
+    if (w.minObjectSpeed < MAX_OBJECT_SPEED) {
+      w.minObjectSpeed += speedBoost;
+      if (w.minObjectSpeed > MAX_OBJECT_SPEED) {
+        w.minObjectSpeed = MAX_OBJECT_SPEED;
+      }
+    }
+
+    if (w.maxObjectSpeedOffset < MAX_OBJECT_SPEED * 0.5f) {
+      w.maxObjectSpeedOffset += speedBoost * 0.5f;
+    }
+
+    // Diminui delay de spawn (aumenta taxa de spawn)
+    w.spawnDelay = static_cast<int>(params.spawnDelayInitial /
+                                    (1.0f + w.difficultyMultiplier * 0.5f));
+    if (w.spawnDelay < params.spawnDelayMinimum) {
+      w.spawnDelay = params.spawnDelayMinimum;
+    }
+
+    // Adiciona objetos gradualmente (até 8 níveis)
+    int targetObjects = std::min(
+        params.maxNumObjects, 2 + std::min(4, (w.difficultyLevel - 1 + 1) / 2));
+    if (w.objects.size() < static_cast<size_t>(targetObjects)) {
+      w.objects.push_back(FallingObject(w));
+    }
+
+    w.events.push(EVENT_LEVEL_UP, PAPER, w.difficultyLevel);
+
+    // Próximo threshold de dificuldade (progressão exponencial suave)
+    w.scoreForNextLevel += static_cast<int>(
+        INITIAL_SCORE_FOR_DIFFICULTY *
+        pow(params.scalingFactor, w.difficultyLevel - 1));
+  }
+}
+
+void simulateWorld(World &world, float dt) {
+  if (world.gameOver) {
+    // A física da chuva de lixo é por tick: passos grandes viram vários
+    // ticks nominais
+    const float tickDt = SIMULATION_TICK_MS / 1000.0f;
+    int ticks = std::max(1, static_cast<int>(dt / tickDt + 0.5f));
+    for (int i = 0; i < ticks; ++i) {
+      updateGameOver(world, dt / ticks);
+    }
+  } else {
+    updatePlaying(world, dt);
+  }
+}
@@ -0,0 +1,16 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "World.h"
+
+// Avança uma partida em um passo de dt segundos (jogo ou, depois do fim, a
+// animação de game over). O passo nominal é SIMULATION_TICK_MS; passos
+// maiores valem por vários ticks, com colisão contínua contra as cestas.
+// Só toca o World recebido: não chama janela, áudio nem arquivos, e os
+// efeitos colaterais saem como eventos em world.events.
+void simulateWorld(World &world, float dt);
+
+// Funções de dificuldade
+void updateDifficulty(World &world);
+
+#endif // SIMULATION_H
@@ -0,0 +1,282 @@
+#include "SimulationThread.h"
+#include "AllocStats.h"
+#include "AudioManager.h"
+#include "AutoplayBot.h"
+#include "FrameArena.h"
+#include "GameState.h"
+#include "MemoryStats.h"
+#include "RankingSystem.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include "WorldSnapshot.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static TripleBuffer<RenderSnapshot> snapshots;
+static SpscQueue<InputCommand, 256> inputQueue;
+static std::thread simulationThread;
+static std::atomic<bool> simulationRunning(false);
+static std::atomic<bool> quitRequested(false);
+static std::atomic<int> rainEmissionOdds(TRASH_RAIN_EMISSION_ODDS);
+static std::atomic<int> rainMaxParticles(TRASH_RAIN_MAX_PARTICLES);
+static std::atomic<bool> autoplay(false);
+static int ticksSinceAutosave = 0;
+static std::vector<unsigned char> autosaveBlob;
+static AutoplayBot autoplayBot;
+static int steppedState = -1; // Estado do jogo no passo anterior
+static int stepsInState = 0;  // Passos desde a última troca de estado
+
+// O autosave é serializado na simulação e gravado em disco por uma thread
+// própria: fopen/fwrite/rename podem demorar (cartão SD, disco ocupado) e
+// não podem segurar o tick. Dois buffers: o passo serializa em
+// autosaveBlob e troca com autosaveWriting; com uma gravação ainda em
+// andamento, o autosave espera o próximo passo.
+static std::thread autosaveThread;
+static std::mutex autosaveMutex;
+static std::condition_variable autosaveWake;
+static std::vector<unsigned char> autosaveWriting;
+static bool autosaveRunning = false;
+static bool autosaveQueued = false;  // autosaveWriting espera gravação
+static bool autosaveDiscard = false; // Apagar o arquivo depois da gravação
+static std::atomic<bool> autosaveBusy(false); // Pedido ainda não atendido
+
+static void autosaveLoop() {
+  std::unique_lock<std::mutex> lock(autosaveMutex);
+  while (true) {
+    autosaveWake.wait(lock, [] {
+      return autosaveQueued || autosaveDiscard || !autosaveRunning;
+    });
+    if (autosaveQueued) {
+      // A simulação não mexe em autosaveWriting enquanto autosaveBusy
+      lock.unlock();
+      writeSnapshotFile(SAVEGAME_FILENAME, autosaveWriting);
+      lock.lock();
+      autosaveQueued = false;
+    }
+    if (autosaveDiscard) {
+      remove(SAVEGAME_FILENAME.c_str());
+      autosaveDiscard = false;
+    }
+    autosaveBusy = false;
+    if (!autosaveRunning) {
+      return;
+    }
+  }
+}
+
+// Memória da partida e de cada uma das três cópias publicadas
+struct SimulationMemory {
+  MemoryAccount particles, objects, ranking;
+  SimulationMemory()
+      : particles(MEMORY_PARTICLES), objects(MEMORY_OBJECTS),
+        ranking(MEMORY_RANKING) {}
+};
+static SimulationMemory worldMemory;
+static SimulationMemory snapshotMemory[3];
+static MemoryAccount rewindMemory(MEMORY_REWIND);
+
+// Copia o estado desenhável; as atribuições reaproveitam a capacidade dos
+// vetores do buffer, então depois dos primeiros ticks não há alocação
+static void publishSnapshot(float tickMs) {
+  RenderSnapshot &s = snapshots.writeBuffer();
+  s.gameState = gameState;
+  s.titleScore = titleScore;
+  s.tickMs = tickMs;
+  s.copyWorld(world);
+
+  s.homeScreenDebris = homeScreenDebris;
+  s.homeScreenAnimationTimer = homeScreenAnimationTimer;
+  s.currentPlayerName = currentPlayerName;
+  s.homeButton = homeButton;
+  s.pauseButtons = pauseButtons;
+  s.ranking = ranking;
+  s.assetsLoading = audioManager.isLoading();
+  s.assetLoadProgress = audioManager.getLoadProgress();
+
+  SimulationMemory &memory = snapshotMemory[snapshots.writeIndex()];
+  memory.particles.track(vectorBytes(s.trashRain) +
+                         vectorBytes(s.settledRain) +
+                         vectorBytes(s.homeScreenDebris));
+  memory.objects.track(vectorBytes(s.objects) + vectorBytes(s.extraBaskets));
+  memory.ranking.track(rankingMemoryBytes(s.ranking));
+
+  snapshots.publish();
+}
+
+// Um passo completo: entrada, simulação, efeitos colaterais e publicação.
+// Normalmente um tick; depois de um engasgo, vale por ticks ticks.
+static void simulationStep(float dt, int ticks) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  // Passado o aquecimento de um estado, o passo não deveria alocar nada
+  if (gameState != steppedState) {
+    steppedState = gameState;
+    stepsInState = 0;
+  }
+  if (stepsInState <= ALLOC_WARMUP_FRAMES) {
+    stepsInState++;
+  }
+  frameArena().reset();
+  allocStatsBeginFrame(stepsInState > ALLOC_WARMUP_FRAMES);
+
+  // Instala os arquivos de áudio que terminaram de carregar
+  audioManager.processLoadedAssets();
+  audioManager.monitorLatency();
+
+  InputCommand command;
+  while (inputQueue.pop(command)) {
+    applyInputCommand(command);
+  }
+  world.rain.emissionOdds = rainEmissionOdds;
+  world.rain.maxParticles = rainMaxParticles;
+
+  if (autoplay && gameState == STATE_PLAYING) {
+    autoplayBot.control(world);
+  }
+
+  // Simulação e, em lote, os efeitos colaterais do tick
+  simulateTick(dt);
+  dispatchGameEvents();
+
+  // Toca de uma vez os efeitos pedidos neste tick
+  audioManager.flushSounds();
+
+  // Salva a partida para retomar após queda ou reinício (--resume)
+  if (gameState == STATE_PLAYING &&
+      (ticksSinceAutosave += ticks) >= AUTOSAVE_INTERVAL_TICKS &&
+      !autosaveBusy) {
+    ticksSinceAutosave = 0;
+    saveWorld(world, autosaveBlob);
+    {
+      std::lock_guard<std::mutex> lock(autosaveMutex);
+      autosaveBlob.swap(autosaveWriting);
+      autosaveQueued = true;
+      autosaveBusy = true;
+    }
+    autosaveWake.notify_one();
+  }
+
+  // O ranking global é contado pelo RankingSystem
+  worldMemory.particles.track(vectorBytes(world.trashRain) +
+                              vectorBytes(world.settledRain) +
+                              vectorBytes(homeScreenDebris));
+  worldMemory.objects.track(vectorBytes(world.objects) +
+                            vectorBytes(world.finishedObjects) +
+                            vectorBytes(world.extraBaskets));
+  rewindMemory.track(rewindBuffer.getMemoryUsed());
+
+  publishSnapshot(std::chrono::duration<float, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count());
+  allocStatsEndFrame("tick");
+}
+
+static void simulationLoop() {
+  const std::chrono::milliseconds tick(SIMULATION_TICK_MS);
+  const float dt = SIMULATION_TICK_MS / 1000.0f;
+  std::chrono::steady_clock::time_point next =
+      std::chrono::steady_clock::now();
+
+  while (simulationRunning) {
+    // Taxa fixa. Ticks atrasados (engasgo do sistema, depurador) são
+    // recuperados num único passo maior, até MAX_CATCHUP_TICKS; a colisão
+    // contínua garante que nenhum objeto atravessa a cesta nesse passo. O
+    // atraso além disso é descartado.
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    int due = 1;
+    if (now > next) {
+      due += static_cast<int>((now - next) / tick);
+    }
+    if (due > MAX_CATCHUP_TICKS) {
+      due = MAX_CATCHUP_TICKS;
+      next = now + tick;
+    } else {
+      next += due * tick;
+    }
+    simulationStep(dt * due, due);
+    std::this_thread::sleep_until(next);
+  }
+}
+
+void startSimulationThread() {
+  if (simulationRunning) {
+    return;
+  }
+  publishSnapshot(0.0f); // display() sempre tem algo para desenhar
+  autosaveBlob.reserve(AUTOSAVE_BLOB_RESERVE); // O autosave não aloca
+  autosaveWriting.reserve(AUTOSAVE_BLOB_RESERVE);
+  autosaveRunning = true;
+  autosaveThread = std::thread(autosaveLoop);
+  simulationRunning = true;
+  simulationThread = std::thread(simulationLoop);
+
+  // Fechar a janela encerra o processo sem passar por renderTimer; a thread
+  // precisa parar antes que os globais sejam destruídos
+  static bool stopRegistered = false;
+  if (!stopRegistered) {
+    stopRegistered = true;
+    atexit(stopSimulationThread);
+  }
+}
+
+void stopSimulationThread() {
+  simulationRunning = false;
+  if (simulationThread.joinable()) {
+    simulationThread.join();
+  }
+
+  // Termina a gravação pendente antes de sair
+  {
+    std::lock_guard<std::mutex> lock(autosaveMutex);
+    autosaveRunning = false;
+  }
+  autosaveWake.notify_one();
+  if (autosaveThread.joinable()) {
+    autosaveThread.join();
+  }
+}
+
+void discardAutosave() {
+  bool queued = false;
+  {
+    std::lock_guard<std::mutex> lock(autosaveMutex);
+    if (autosaveRunning) {
+      autosaveDiscard = true;
+      autosaveBusy = true;
+      queued = true;
+    }
+  }
+  if (queued) {
+    autosaveWake.notify_one();
+  } else {
+    remove(SAVEGAME_FILENAME.c_str()); // Sem a thread de gravação
+  }
+}
+
+void setAutoplay(bool enabled) { autoplay = enabled; }
+
+bool pushInputCommand(const InputCommand &command) {
+  return inputQueue.push(command);
+}
+
+void setRainQuality(int emissionOdds, int maxParticles) {
+  rainEmissionOdds = emissionOdds;
+  rainMaxParticles = maxParticles;
+}
+
+const RenderSnapshot &acquireLatestSnapshot() {
+  snapshots.acquire();
+  return snapshots.readBuffer();
+}
+
+bool isQuitRequested() { return quitRequested; }
+
+void requestQuit() { quitRequested = true; }
@@ -0,0 +1,29 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include "InputHandler.h"
+#include "RenderSnapshot.h"
+
+// A simulação roda em uma thread própria a uma taxa fixa e publica cópias
+// do estado em um buffer triplo; a thread do GLUT só desenha a mais recente
+// e envia a entrada por uma fila sem travas.
+void startSimulationThread();
+void stopSimulationThread();
+
+// O AutoplayBot controla a cesta durante o jogo (--autoplay); pode ser
+// ligado e desligado com a simulação rodando
+void setAutoplay(bool enabled);
+
+// Thread do GLUT
+bool pushInputCommand(const InputCommand &command);
+void setRainQuality(int emissionOdds, int maxParticles); // Próximo tick
+const RenderSnapshot &acquireLatestSnapshot();
+bool isQuitRequested();
+
+// Thread de simulação
+void requestQuit();
+// Apaga o autosave (partida terminada ou abandonada), depois de qualquer
+// gravação ainda em andamento
+void discardAutosave();
+
+#endif // SIMULATION_THREAD_H
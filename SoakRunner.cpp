@@ -0,0 +1,264 @@
+// Joga milhares de partidas sem janela com o AutoplayBot, em todos os
+// núcleos, e mostra a distribuição de pontuação, a duração das partidas e
+// a vazão da simulação. Serve para testes de longa duração e como carga de
+// CPU realista para profiling.
+//
+// Com --step N cada passo da simulação vale N ticks (tick lento ou
+// recuperação de engasgo); a distribuição deve ficar perto da de --step 1.
+// Compilado com make ALLOCSTATS=1, falha se algum tick alocar memória.
+// Falha também se um passo anunciar o game over mais de uma vez.
+//
+// Uso: ./soakrunner [--games N] [--threads N] [--delay TICKS] [--error TAXA]
+//                   [--max-seconds S] [--seed S] [--step TICKS]
+#include "AllocStats.h"
+#include "AutoplayBot.h"
+#include "GameEvents.h"
+#include "Simulation.h"
+#include "World.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SoakOptions {
+  int games;
+  int threads;
+  int reactionDelayTicks;
+  float errorRate;
+  int maxGameSeconds; // Partidas mais longas são encerradas e contadas à parte
+  unsigned int seed;
+  int stepTicks; // Ticks nominais por passo da simulação
+};
+
+struct GameResult {
+  int score;
+  int level;
+  long long ticks;
+  bool capped;
+  int gameOverEvents;
+};
+
+static bool parseOptions(int argc, char **argv, SoakOptions &options) {
+  options.games = 10000;
+  options.threads = std::max(1u, std::thread::hardware_concurrency());
+  options.reactionDelayTicks = 10;
+  options.errorRate = 0.05f;
+  options.maxGameSeconds = 1800;
+  options.seed = 1;
+  options.stepTicks = 1;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char *value = argv[i + 1];
+    if (strcmp(argv[i], "--games") == 0) {
+      options.games = atoi(value);
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      options.threads = atoi(value);
+    } else if (strcmp(argv[i], "--delay") == 0) {
+      options.reactionDelayTicks = atoi(value);
+    } else if (strcmp(argv[i], "--error") == 0) {
+      options.errorRate = static_cast<float>(atof(value));
+    } else if (strcmp(argv[i], "--max-seconds") == 0) {
+      options.maxGameSeconds = atoi(value);
+    } else if (strcmp(argv[i], "--seed") == 0) {
+      options.seed = static_cast<unsigned int>(strtoul(value, 0, 10));
+    } else if (strcmp(argv[i], "--step") == 0) {
+      options.stepTicks = atoi(value);
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1 && options.games > 0 && options.threads > 0 &&
+         options.maxGameSeconds > 0 && options.stepTicks > 0;
+}
+
+static int countGameOverEvents(const World &world) {
+  int count = 0;
+  for (int i = 0; i < world.events.count; ++i) {
+    count += world.events.events[i].type == EVENT_GAME_OVER ? 1 : 0;
+  }
+  return count;
+}
+
+// Um passo de recuperação (MAX_CATCHUP_TICKS ticks) com o último erro
+// disponível e vários objetos chegando ao chão: o game over sai uma vez só
+static bool checkSingleGameOver() {
+  World world(1);
+  world.misses = MAX_MISSES - 1;
+  world.objects.clear();
+  for (int i = 0; i < 4; ++i) {
+    FallingObject obj(world);
+    obj.x = -0.9f + 0.3f * i;
+    obj.y = -0.75f;
+    world.objects.push_back(obj);
+  }
+  world.basket.x = 0.9f;
+  simulateWorld(world, MAX_CATCHUP_TICKS * SIMULATION_TICK_MS / 1000.0f);
+
+  int gameOvers = countGameOverEvents(world);
+  if (!world.gameOver || gameOvers != 1 || world.misses != MAX_MISSES) {
+    fprintf(stderr,
+            "Erro: passo de %d ticks gerou %d eventos de game over "
+            "(%d erros)\n",
+            MAX_CATCHUP_TICKS, gameOvers, world.misses);
+    return false;
+  }
+  return true;
+}
+
+// Uma partida completa, do início ao game over (ou ao limite de tempo)
+static GameResult playGame(const SoakOptions &options, unsigned int seed) {
+  const float dt = options.stepTicks * SIMULATION_TICK_MS / 1000.0f;
+  const long long maxTicks =
+      options.maxGameSeconds * 1000LL / SIMULATION_TICK_MS;
+
+  World world(seed);
+  AutoplayBot bot(options.reactionDelayTicks, options.errorRate,
+                  seed * 2654435761u);
+
+  GameResult result;
+  result.ticks = 0;
+  result.gameOverEvents = 0;
+  while (!world.gameOver && result.ticks < maxTicks) {
+    // World::reset() já reservou tudo: nenhum tick deveria alocar
+    allocStatsBeginFrame(true);
+    bot.control(world);
+    simulateWorld(world, dt);
+    result.gameOverEvents += countGameOverEvents(world);
+    world.events.clear();
+    allocStatsEndFrame("tick");
+    result.ticks += options.stepTicks;
+  }
+  result.score = world.score;
+  result.level = world.difficultyLevel;
+  result.capped = !world.gameOver;
+  return result;
+}
+
+template <typename T> static T percentile(const std::vector<T> &sorted,
+                                          double p) {
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[index];
+}
+
+static void printDistribution(const char *label, std::vector<double> values,
+                              const char *unit) {
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (size_t i = 0; i < values.size(); ++i) {
+    sum += values[i];
+  }
+  printf("%s (%s): media %.1f | min %.1f | p10 %.1f | p50 %.1f | p90 %.1f | "
+         "p99 %.1f | max %.1f\n",
+         label, unit, sum / values.size(), values.front(),
+         percentile(values, 0.10), percentile(values, 0.50),
+         percentile(values, 0.90), percentile(values, 0.99), values.back());
+}
+
+// Histograma de texto com 10 faixas entre o mínimo e o máximo
+static void printHistogram(const std::vector<double> &values) {
+  const int buckets = 10;
+  double lo = *std::min_element(values.begin(), values.end());
+  double hi = *std::max_element(values.begin(), values.end());
+  double width = (hi - lo) / buckets;
+  if (width <= 0.0) {
+    width = 1.0;
+  }
+
+  int counts[buckets] = {0};
+  for (size_t i = 0; i < values.size(); ++i) {
+    int b = static_cast<int>((values[i] - lo) / width);
+    counts[std::min(b, buckets - 1)]++;
+  }
+  int peak = *std::max_element(counts, counts + buckets);
+  for (int b = 0; b < buckets; ++b) {
+    int bar = peak > 0 ? counts[b] * 50 / peak : 0;
+    printf("  %7.0f - %7.0f | %6d %s\n", lo + b * width, lo + (b + 1) * width,
+           counts[b], std::string(bar, '#').c_str());
+  }
+}
+
+int main(int argc, char **argv) {
+  SoakOptions options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr,
+            "Uso: %s [--games N] [--threads N] [--delay TICKS] "
+            "[--error TAXA] [--max-seconds S] [--seed S] [--step TICKS]\n",
+            argv[0]);
+    return 1;
+  }
+  if (!checkSingleGameOver()) {
+    return 1;
+  }
+
+  printf("%d partidas, %d threads, reacao %d passos, erro %.0f%%, limite "
+         "%d s, %d tick(s) por passo\n",
+         options.games, options.threads, options.reactionDelayTicks,
+         options.errorRate * 100.0f, options.maxGameSeconds,
+         options.stepTicks);
+
+  std::vector<GameResult> results(options.games);
+  std::atomic<int> nextGame(0);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; ++t) {
+    threads.push_back(std::thread([&]() {
+      int game;
+      while ((game = nextGame++) < options.games) {
+        results[game] =
+            playGame(options, options.seed + static_cast<unsigned int>(game));
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::vector<double> scores, lengths, levels;
+  long long totalTicks = 0;
+  int capped = 0, repeatedGameOver = 0;
+  for (size_t i = 0; i < results.size(); ++i) {
+    repeatedGameOver += results[i].gameOverEvents > 1 ? 1 : 0;
+    scores.push_back(results[i].score);
+    levels.push_back(results[i].level);
+    lengths.push_back(results[i].ticks * SIMULATION_TICK_MS / 1000.0);
+    totalTicks += results[i].ticks;
+    capped += results[i].capped ? 1 : 0;
+  }
+
+  printf("\n");
+  printDistribution("Pontuacao", scores, "pontos");
+  printHistogram(scores);
+  printDistribution("Nivel final", levels, "nivel");
+  printDistribution("Duracao", lengths, "s de jogo");
+  if (capped > 0) {
+    printf("%d partidas atingiram o limite de %d s\n", capped,
+           options.maxGameSeconds);
+  }
+
+  double gameSeconds = totalTicks * SIMULATION_TICK_MS / 1000.0;
+  printf("\nVazao: %.0f partidas/s | %.0f ticks/s | %.0f s de jogo/s "
+         "(%.2f s de parede)\n",
+         options.games / seconds, totalTicks / seconds, gameSeconds / seconds,
+         seconds);
+  if (repeatedGameOver > 0) {
+    fprintf(stderr, "Erro: %d partidas anunciaram o game over mais de uma "
+                    "vez\n",
+            repeatedGameOver);
+    return 1;
+  }
+  if (allocStatsEnabled()) {
+    allocStatsReport();
+    return allocStatsViolations() > 0 ? 1 : 0;
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Fila circular sem travas para um produtor e um consumidor. Capacity deve
+// ser potência de dois; cabem Capacity - 1 itens.
+template <typename T, size_t Capacity> class SpscQueue {
+private:
+  T items[Capacity];
+  std::atomic<size_t> head; // Próximo a ler (consumidor)
+  std::atomic<size_t> tail; // Próximo a escrever (produtor)
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+
+  bool push(const T &item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t next = (t + 1) & (Capacity - 1);
+    if (next == head.load(std::memory_order_acquire)) {
+      return false; // Cheia
+    }
+    items[t] = item;
+    tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+      return false; // Vazia
+    }
+    item = items[h];
+    head.store((h + 1) & (Capacity - 1), std::memory_order_release);
+    return true;
+  }
+};
+
+#endif // SPSC_QUEUE_H
@@ -1,4 +1,5 @@
 #include "TextRenderer.h"
+#include "GlStats.h"
 #include <GL/glut.h>
 
 void renderBitmapText(float x, float y, void *font, const char *string) {
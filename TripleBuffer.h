@@ -0,0 +1,41 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Buffer triplo sem travas entre um escritor e um leitor. O escritor
+// preenche writeBuffer() e chama publish(); o leitor chama acquire() e lê
+// readBuffer(), que nunca é tocado pelo escritor enquanto estiver em uso.
+// O escritor deve sobrescrever todo o conteúdo a cada publicação, pois o
+// buffer recebido pode ser de duas publicações atrás.
+template <typename T> class TripleBuffer {
+private:
+  static const int INDEX_MASK = 3;
+  static const int DIRTY = 4; // O buffer do meio tem dados não lidos
+
+  T buffers[3];
+  std::atomic<int> middle;
+  int back;  // Só o escritor usa
+  int front; // Só o leitor usa
+
+public:
+  TripleBuffer() : middle(1), back(0), front(2) {}
+
+  T &writeBuffer() { return buffers[back]; }
+  int writeIndex() const { return back; } // 0..2, estável por buffer
+
+  void publish() { back = middle.exchange(back | DIRTY) & INDEX_MASK; }
+
+  // Troca para a publicação mais recente; false se não houver nada novo
+  bool acquire() {
+    if ((middle.load() & DIRTY) == 0) {
+      return false;
+    }
+    front = middle.exchange(front) & INDEX_MASK;
+    return true;
+  }
+
+  const T &readBuffer() const { return buffers[front]; }
+};
+
+#endif // TRIPLE_BUFFER_H
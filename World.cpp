@@ -0,0 +1,116 @@
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+
+DifficultyParams::DifficultyParams()
+    : speedIncreaseRate(SPEED_INCREASE_RATE),
+      scalingFactor(DIFFICULTY_SCALING_FACTOR),
+      spawnDelayInitial(SPAWN_DELAY_INITIAL),
+      spawnDelayMinimum(SPAWN_DELAY_MINIMUM), maxNumObjects(MAX_NUM_OBJECTS) {}
+
+World::World(unsigned int seed) {
+  this->seed(seed);
+  reset();
+}
+
+void World::reset() {
+  score = 0;
+  misses = 0;
+  moveLeft = moveRight = false;
+  gameOver = false;
+
+  minObjectSpeed = INITIAL_MIN_OBJECT_SPEED;
+  maxObjectSpeedOffset = INITIAL_MAX_OBJECT_SPEED_OFFSET;
+  scoreForNextLevel = INITIAL_SCORE_FOR_DIFFICULTY;
+  difficultyLevel = 1;
+  spawnDelay = difficulty.spawnDelayInitial;
+  spawnTimer = 0;
+  difficultyMultiplier = 1.0f;
+
+  // Capacidade reservada uma vez: a chuva e os objetos não realocam no
+  // meio da partida (clear() mantém o que já foi reservado)
+  trashRain.clear();
+  trashRain.reserve(TRASH_RAIN_MAX_FALLING);
+  settledRain.clear();
+  settledRain.reserve(std::max(rain.maxParticles, TRASH_RAIN_MAX_PARTICLES));
+  gameOverAnimationTimer = 0.0f;
+  displayedScore = 0;
+  finalScoreHolder = 0;
+  gameOverBasketAngle = 0.0f;
+  gameOverBasketY = 0.0f;
+
+  time = 0.0f;
+  events.clear();
+
+  size_t maxObjects = static_cast<size_t>(
+      std::max(difficulty.maxNumObjects, stress.objectCount));
+  objects.clear();
+  objects.reserve(maxObjects);
+  finishedObjects.reserve(maxObjects);
+  laneTail.reserve(laneCount());
+  objects.push_back(FallingObject(*this));
+  basket.x = 0.0f;
+  basket.wasteType = PAPER;
+
+  extraBaskets.assign(stress.basketCount, Basket());
+  placeExtraBaskets();
+}
+
+int World::laneCount() const {
+  return isStress() ? static_cast<int>(1.8f / STRESS_SPAWN_DISTANCE)
+                    : SPAWN_LANE_COUNT;
+}
+
+float World::objectSize() const {
+  return isStress() ? STRESS_OBJECT_SIZE : OBJECT_SIZE;
+}
+
+float World::spawnDistance() const {
+  return isStress() ? STRESS_SPAWN_DISTANCE : MIN_SPAWN_DISTANCE;
+}
+
+// As cestas automáticas vão e voltam com fases diferentes, cada uma de um
+// tipo; como só dependem do tempo, snapshots e rewind não as guardam
+float World::extraBasketX(size_t index, float t) const {
+  float phase = static_cast<float>(index) * 2.4f;
+  return (1.0f - extraBaskets[index].width / 2.0f) *
+         sinf(t * (0.6f + 0.1f * index) + phase);
+}
+
+void World::placeExtraBaskets() {
+  for (size_t i = 0; i < extraBaskets.size(); ++i) {
+    extraBaskets[i].x = extraBasketX(i, time);
+    extraBaskets[i].wasteType =
+        static_cast<WASTE_TYPE>((i + 1) % WASTE_TYPE_COUNT);
+  }
+}
+
+void World::settleStoppedParticles() {
+  for (size_t i = 0; i < trashRain.size();) {
+    if (trashRain[i].estatico) {
+      settledRain.push_back(packSettledParticle(trashRain[i]));
+      trashRain[i] = trashRain.back();
+      trashRain.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+void World::seed(unsigned int seed) {
+  rngState = seed != 0 ? seed : 1; // xorshift não sai do zero
+}
+
+// xorshift32: rápido, sem estado compartilhado e reproduzível por semente
+unsigned int World::nextRandom() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+float World::randomFloat() {
+  return (nextRandom() >> 8) * (1.0f / 16777215.0f);
+}
+
+int World::randomInt(int n) { return static_cast<int>(nextRandom() % n); }
@@ -0,0 +1,106 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "GameConstants.h"
+#include "GameEvents.h"
+#include "GameObjects.h"
+#include <vector>
+
+// Parâmetros da curva de dificuldade. O padrão vem de GameConstants.h; o
+// analisador de dificuldade varia esses valores entre partidas.
+struct DifficultyParams {
+  float speedIncreaseRate; // SPEED_INCREASE_RATE
+  float scalingFactor;     // DIFFICULTY_SCALING_FACTOR
+  int spawnDelayInitial;   // SPAWN_DELAY_INITIAL
+  int spawnDelayMinimum;   // SPAWN_DELAY_MINIMUM
+  int maxNumObjects;       // MAX_NUM_OBJECTS
+
+  DifficultyParams();
+};
+
+// Modo stress: milhares de objetos menores e cestas automáticas além da
+// do jogador. Os erros não terminam a partida, então ela serve também de
+// benchmark de escala do caminho de jogo (stressbench).
+struct StressParams {
+  int objectCount; // 0 = jogo normal
+  int basketCount; // Cestas automáticas
+
+  StressParams() : objectCount(0), basketCount(0) {}
+};
+
+// Chuva de lixo do game over. É qualidade visual, não estado da partida:
+// o governador de qualidade reduz em máquinas lentas e nada disso é salvo.
+struct RainParams {
+  int emissionOdds; // TRASH_RAIN_EMISSION_ODDS
+  int maxParticles; // TRASH_RAIN_MAX_PARTICLES
+
+  RainParams()
+      : emissionOdds(TRASH_RAIN_EMISSION_ODDS),
+        maxParticles(TRASH_RAIN_MAX_PARTICLES) {}
+};
+
+// Estado completo de uma partida. Não há globais na simulação: várias
+// partidas independentes podem rodar ao mesmo tempo, uma por thread.
+struct World {
+  std::vector<FallingObject> objects;
+  Basket basket;
+  int score;
+  int misses;
+  bool moveLeft, moveRight; // Direção pedida para a cesta
+  bool gameOver;
+
+  // Dificuldade Dinâmica
+  DifficultyParams difficulty; // Preservado por reset()
+  float minObjectSpeed;
+  float maxObjectSpeedOffset;
+  int scoreForNextLevel;
+  int difficultyLevel;
+  int spawnDelay;
+  int spawnTimer;
+  float difficultyMultiplier;
+
+  // Animação de Game Over
+  RainParams rain; // Preservado por reset()
+  std::vector<TrashParticle> trashRain;      // Ainda caindo
+  std::vector<SettledParticle> settledRain; // Pilha, em ordem de parada
+  float gameOverAnimationTimer;
+  int displayedScore, finalScoreHolder;
+  float gameOverBasketAngle;
+  float gameOverBasketY;
+
+  // Modo stress
+  StressParams stress;              // Preservado por reset()
+  std::vector<Basket> extraBaskets; // Posição depende só de time
+
+  // Temporários da simulação (só evitam alocar a cada tick; não fazem
+  // parte do estado salvo)
+  std::vector<FallingObject> finishedObjects; // Saíram da tela no tick
+  std::vector<int> laneTail; // Último objeto mantido em cada faixa
+
+  float time;            // Tempo simulado de jogo em segundos
+  GameEventQueue events; // Eventos do tick atual
+  unsigned int rngState; // Gerador próprio: rand() é global e não reentrante
+
+  explicit World(unsigned int seed = 1);
+
+  // Começa uma nova partida (mantém o estado do gerador)
+  void reset();
+  void seed(unsigned int seed);
+
+  bool isStress() const { return stress.objectCount > 0; }
+  int laneCount() const;
+  float objectSize() const;
+  float spawnDistance() const;
+  float extraBasketX(size_t index, float t) const; // Cesta automática em t
+  void placeExtraBaskets(); // Recalcula as cestas automáticas para time
+  // Passa as partículas de trashRain que pararam para settledRain
+  // (compactadas). A última que cai ocupa o lugar de cada uma que saiu: as
+  // outras ficam na mesma posição, e o delta do rewind continua pequeno
+  void settleStoppedParticles();
+
+  unsigned int nextRandom();
+  float randomFloat(); // Uniforme em [0, 1]
+  int randomInt(int n); // Uniforme em [0, n)
+};
+
+#endif // WORLD_H
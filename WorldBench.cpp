@@ -0,0 +1,189 @@
+// Benchmark da simulação sem janela: roda N partidas independentes em
+// paralelo, uma thread por núcleo, e mede ticks simulados por segundo.
+//
+// Uso: ./worldbench [partidas] [segundos de jogo por partida] [estado.bin]
+//
+// Com um snapshot (por exemplo o savegame.bin do jogo), cada partida começa
+// e recomeça nesse estado, medindo o fim de jogo sem jogar o começo.
+//
+// No fim, mede o custo do histórico de rewind: partidas do AutoplayBot
+// simuladas com RewindBuffer::capture a cada tick, com o jogo e o game over
+// mostrados à parte.
+#include "AutoplayBot.h"
+#include "RewindBuffer.h"
+#include "Simulation.h"
+#include "World.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+struct BenchResult {
+  long long ticks;
+  long long games;
+  double seconds;
+};
+
+// Cada thread pega a próxima partida livre até acabarem
+static BenchResult runWorlds(int worldCount, long long ticksPerWorld,
+                             int threadCount,
+                             const std::vector<unsigned char> &state) {
+  const float dt = SIMULATION_TICK_MS / 1000.0f;
+  std::atomic<int> nextWorld(0);
+  std::atomic<long long> totalTicks(0), totalGames(0);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&]() {
+      int index;
+      while ((index = nextWorld++) < worldCount) {
+        unsigned int seed = static_cast<unsigned int>(index + 1);
+        World world(seed);
+        if (!state.empty()) {
+          restoreWorld(world, &state[0], state.size());
+          world.seed(seed); // Mesmo ponto de partida, partidas diferentes
+        }
+        long long games = 0;
+        for (long long tick = 0; tick < ticksPerWorld; ++tick) {
+          simulateWorld(world, dt);
+          world.events.clear();
+          if (world.gameOver) {
+            games++;
+            if (state.empty()) {
+              world.reset();
+            } else {
+              restoreWorld(world, &state[0], state.size());
+            }
+          }
+        }
+        totalTicks += ticksPerWorld;
+        totalGames += games;
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) {
+    threads[t].join();
+  }
+
+  BenchResult result;
+  result.ticks = totalTicks;
+  result.games = totalGames;
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return result;
+}
+
+// Custo acumulado de simulação e captura numa fase da partida
+struct RewindCost {
+  long long ticks;
+  double simSeconds, captureSeconds;
+  RewindCost() : ticks(0), simSeconds(0.0), captureSeconds(0.0) {}
+};
+
+static void printRewindCost(const char *phase, const RewindCost &c) {
+  if (c.ticks == 0) {
+    return;
+  }
+  printf("rewind (%s): simulacao %.3f us/tick, captura %.3f us/tick "
+         "(%.1f%%)\n",
+         phase, c.simSeconds * 1e6 / c.ticks, c.captureSeconds * 1e6 / c.ticks,
+         c.captureSeconds * 100.0 / c.simSeconds);
+}
+
+// Simula partidas (semente fixa) jogadas pelo AutoplayBot, capturando o
+// histórico a cada tick, e cronometra separadamente a simulação e a
+// captura, durante o jogo e durante o game over
+static void measureRewind(long long ticks) {
+  typedef std::chrono::steady_clock Clock;
+  const float dt = SIMULATION_TICK_MS / 1000.0f;
+  RewindBuffer rewind(REWIND_MAX_FRAMES, REWIND_MEMORY_BUDGET,
+                      REWIND_KEYFRAME_INTERVAL);
+  World world(1);
+  AutoplayBot bot(10, 0.05f, 1);
+  long long gameOverTicks = 0;
+  RewindCost playing, gameOver;
+
+  for (long long tick = 0; tick < ticks; ++tick) {
+    RewindCost &cost = world.gameOver ? gameOver : playing;
+    if (!world.gameOver) {
+      bot.control(world);
+    }
+    Clock::time_point t0 = Clock::now();
+    simulateWorld(world, dt);
+    world.events.clear();
+    Clock::time_point t1 = Clock::now();
+    rewind.capture(world);
+    Clock::time_point t2 = Clock::now();
+    cost.ticks++;
+    cost.simSeconds += std::chrono::duration<double>(t1 - t0).count();
+    cost.captureSeconds += std::chrono::duration<double>(t2 - t1).count();
+
+    // Fica 30 s na tela de game over, com a chuva de lixo, e recomeça
+    if (world.gameOver && ++gameOverTicks * SIMULATION_TICK_MS > 30000) {
+      world.reset();
+      rewind.clear();
+      gameOverTicks = 0;
+    }
+  }
+  printRewindCost("jogo", playing);
+  printRewindCost("game over", gameOver);
+  printf("rewind: %zu quadros em %zu KB\n", rewind.getFrameCount(),
+         rewind.getMemoryUsed() / 1024);
+}
+
+static void printResult(const char *label, int threadCount,
+                        const BenchResult &r) {
+  double ticksPerSecond = r.ticks / r.seconds;
+  printf("%-10s %2d threads: %lld ticks em %.2f s = %.0f ticks/s "
+         "(%.0fx tempo real), %lld partidas\n",
+         label, threadCount, r.ticks, r.seconds, ticksPerSecond,
+         ticksPerSecond * SIMULATION_TICK_MS / 1000.0, r.games);
+}
+
+int main(int argc, char **argv) {
+  int cores = std::max(1u, std::thread::hardware_concurrency());
+  int worldCount = argc > 1 ? atoi(argv[1]) : cores * 4;
+  int gameSeconds = argc > 2 ? atoi(argv[2]) : 600;
+  if (worldCount <= 0 || gameSeconds <= 0) {
+    fprintf(stderr,
+            "Uso: %s [partidas] [segundos de jogo por partida] [estado.bin]\n",
+            argv[0]);
+    return 1;
+  }
+  long long ticksPerWorld = gameSeconds * 1000LL / SIMULATION_TICK_MS;
+
+  std::vector<unsigned char> state;
+  if (argc > 3) {
+    World saved;
+    if (!loadWorldFromFile(saved, argv[3]) || saved.gameOver) {
+      fprintf(stderr, "Erro: %s nao e um snapshot de partida em andamento\n",
+              argv[3]);
+      return 1;
+    }
+    saveWorld(saved, state);
+    printf("Partindo de %s: nivel %d, %d pontos, %d objetos\n", argv[3],
+           saved.difficultyLevel, saved.score,
+           static_cast<int>(saved.objects.size()));
+  }
+
+  printf("%d partidas x %d s de jogo (%lld ticks cada), %d nucleos\n",
+         worldCount, gameSeconds, ticksPerWorld, cores);
+
+  BenchResult serial = runWorlds(worldCount, ticksPerWorld, 1, state);
+  printResult("serial", 1, serial);
+  if (cores > 1) {
+    BenchResult parallel = runWorlds(worldCount, ticksPerWorld, cores, state);
+    printResult("paralelo", cores, parallel);
+    printf("Aceleracao: %.2fx\n", serial.seconds / parallel.seconds);
+  }
+  measureRewind(ticksPerWorld);
+  return 0;
+}
@@ -0,0 +1,477 @@
+#include "WorldSnapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Tags das seções (quatro letras legíveis em um dump hexadecimal)
+static uint32_t makeTag(const char name[5]) {
+  return static_cast<uint32_t>(name[0]) |
+         (static_cast<uint32_t>(name[1]) << 8) |
+         (static_cast<uint32_t>(name[2]) << 16) |
+         (static_cast<uint32_t>(name[3]) << 24);
+}
+
+static const uint32_t TAG_CORE = makeTag("CORE");
+static const uint32_t TAG_DIFFICULTY = makeTag("DIFF");
+static const uint32_t TAG_BASKET = makeTag("BASK");
+static const uint32_t TAG_OBJECTS = makeTag("OBJS");
+static const uint32_t TAG_GAME_OVER = makeTag("GOVR");
+static const uint32_t TAG_TRASH_RAIN = makeTag("RAIN");
+static const uint32_t TAG_SETTLED_RAIN = makeTag("SETL");
+static const uint32_t TAG_STRESS = makeTag("STRS");
+
+// Escrita sequencial de campos, com seções de tamanho preenchido no fim
+class SnapshotWriter {
+private:
+  std::vector<unsigned char> &out;
+  size_t sectionStart;
+
+public:
+  uint32_t sectionCount;
+
+  explicit SnapshotWriter(std::vector<unsigned char> &buffer)
+      : out(buffer), sectionStart(0), sectionCount(0) {}
+
+  void bytes(const void *data, size_t size) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    out.insert(out.end(), p, p + size);
+  }
+
+  template <typename T> void put(const T &value) {
+    bytes(&value, sizeof(T));
+  }
+
+  void beginSection(uint32_t tag) {
+    put(tag);
+    put(static_cast<uint32_t>(0));
+    sectionStart = out.size();
+  }
+
+  size_t position() const { return out.size(); }
+
+  void patch(size_t pos, uint32_t value) {
+    memcpy(&out[pos], &value, sizeof(value));
+  }
+
+  void endSection() {
+    uint32_t length = static_cast<uint32_t>(out.size() - sectionStart);
+    memcpy(&out[sectionStart - sizeof(uint32_t)], &length, sizeof(length));
+    sectionCount++;
+  }
+};
+
+// Leitura de uma seção ou registro: get() devolve false (e não altera o
+// destino) depois do fim, o que mantém os padrões de campos que uma versão
+// antiga não gravou
+class SnapshotReader {
+private:
+  const unsigned char *data;
+  size_t size, pos;
+
+public:
+  SnapshotReader(const unsigned char *d, size_t s) : data(d), size(s), pos(0) {}
+
+  template <typename T> bool get(T &value) {
+    if (pos + sizeof(T) > size) {
+      pos = size;
+      return false;
+    }
+    memcpy(&value, data + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  // Bloco de n bytes como um leitor próprio
+  bool sub(size_t n, SnapshotReader &reader) {
+    if (pos + n > size) {
+      return false;
+    }
+    reader = SnapshotReader(data + pos, n);
+    pos += n;
+    return true;
+  }
+
+  bool atEnd() const { return pos >= size; }
+  size_t remaining() const { return size - pos; }
+};
+
+static void putObject(SnapshotWriter &w, const FallingObject &o) {
+  w.put(o.x);
+  w.put(o.y);
+  w.put(o.size);
+  w.put(o.speed);
+  w.put(o.rotation);
+  w.put(o.rotationSpeed);
+  w.put(o.spawnTime);
+  w.put(static_cast<int32_t>(o.wasteType));
+  w.put(static_cast<int32_t>(o.lane));
+}
+
+static void getObject(SnapshotReader &r, FallingObject &o) {
+  int32_t type = o.wasteType;
+  r.get(o.x);
+  r.get(o.y);
+  r.get(o.size);
+  r.get(o.speed);
+  r.get(o.rotation);
+  r.get(o.rotationSpeed);
+  r.get(o.spawnTime);
+  r.get(type);
+  o.wasteType = static_cast<WASTE_TYPE>(type);
+  int32_t lane = o.lane;
+  r.get(lane);
+  o.lane = lane;
+}
+
+static void putParticle(SnapshotWriter &w, const TrashParticle &p) {
+  w.put(p.x);
+  w.put(p.y);
+  w.put(p.vx);
+  w.put(p.vy);
+  w.put(p.rotation);
+  w.put(p.rotationSpeed);
+  w.put(p.size);
+  w.put(p.largura);
+  w.put(p.altura);
+  w.put(static_cast<uint8_t>(p.estatico));
+  w.put(static_cast<int32_t>(p.type));
+}
+
+static void getParticle(SnapshotReader &r, TrashParticle &p) {
+  uint8_t estatico = 0;
+  int32_t type = PAPER;
+  r.get(p.x);
+  r.get(p.y);
+  r.get(p.vx);
+  r.get(p.vy);
+  r.get(p.rotation);
+  r.get(p.rotationSpeed);
+  r.get(p.size);
+  r.get(p.largura);
+  r.get(p.altura);
+  r.get(estatico);
+  r.get(type);
+  p.estatico = estatico != 0;
+  p.type = static_cast<WASTE_TYPE>(type);
+}
+
+static void putSettled(SnapshotWriter &w, const SettledParticle &p) {
+  w.put(p.x);
+  w.put(p.y);
+  w.put(p.rotation);
+  w.put(p.size);
+  w.put(p.type);
+}
+
+static void getSettled(SnapshotReader &r, SettledParticle &p) {
+  r.get(p.x);
+  r.get(p.y);
+  r.get(p.rotation);
+  r.get(p.size);
+  r.get(p.type);
+}
+
+void saveWorld(const World &world, std::vector<unsigned char> &out) {
+  out.clear();
+  WorldSnapshotHeader header;
+  memcpy(header.magic, WORLD_SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = WORLD_SNAPSHOT_VERSION;
+  header.sectionCount = 0;
+  header.reserved = 0;
+
+  SnapshotWriter w(out);
+  w.put(header);
+
+  w.beginSection(TAG_CORE);
+  w.put(static_cast<int32_t>(world.score));
+  w.put(static_cast<int32_t>(world.misses));
+  w.put(static_cast<uint8_t>(world.gameOver));
+  w.put(static_cast<uint8_t>(world.moveLeft));
+  w.put(static_cast<uint8_t>(world.moveRight));
+  w.put(world.time);
+  w.put(static_cast<uint32_t>(world.rngState));
+  w.endSection();
+
+  const DifficultyParams &params = world.difficulty;
+  w.beginSection(TAG_DIFFICULTY);
+  w.put(params.speedIncreaseRate);
+  w.put(params.scalingFactor);
+  w.put(static_cast<int32_t>(params.spawnDelayInitial));
+  w.put(static_cast<int32_t>(params.spawnDelayMinimum));
+  w.put(static_cast<int32_t>(params.maxNumObjects));
+  w.put(world.minObjectSpeed);
+  w.put(world.maxObjectSpeedOffset);
+  w.put(static_cast<int32_t>(world.scoreForNextLevel));
+  w.put(static_cast<int32_t>(world.difficultyLevel));
+  w.put(static_cast<int32_t>(world.spawnDelay));
+  w.put(static_cast<int32_t>(world.spawnTimer));
+  w.put(world.difficultyMultiplier);
+  w.endSection();
+
+  const Basket &b = world.basket;
+  w.beginSection(TAG_BASKET);
+  w.put(b.x);
+  w.put(b.y);
+  w.put(b.width);
+  w.put(b.height);
+  w.put(b.speed);
+  w.put(static_cast<int32_t>(b.wasteType));
+  w.endSection();
+
+  w.beginSection(TAG_OBJECTS);
+  w.put(static_cast<uint32_t>(world.objects.size()));
+  size_t recordSizePos = w.position();
+  w.put(static_cast<uint32_t>(0));
+  for (size_t i = 0; i < world.objects.size(); ++i) {
+    putObject(w, world.objects[i]);
+  }
+  if (!world.objects.empty()) {
+    w.patch(recordSizePos, static_cast<uint32_t>(
+                               (w.position() - recordSizePos - 4) /
+                               world.objects.size()));
+  }
+  w.endSection();
+
+  w.beginSection(TAG_GAME_OVER);
+  w.put(world.gameOverAnimationTimer);
+  w.put(static_cast<int32_t>(world.displayedScore));
+  w.put(static_cast<int32_t>(world.finalScoreHolder));
+  w.put(world.gameOverBasketAngle);
+  w.put(world.gameOverBasketY);
+  w.endSection();
+
+  w.beginSection(TAG_TRASH_RAIN);
+  w.put(static_cast<uint32_t>(world.trashRain.size()));
+  recordSizePos = w.position();
+  w.put(static_cast<uint32_t>(0));
+  for (size_t i = 0; i < world.trashRain.size(); ++i) {
+    putParticle(w, world.trashRain[i]);
+  }
+  if (!world.trashRain.empty()) {
+    w.patch(recordSizePos, static_cast<uint32_t>(
+                               (w.position() - recordSizePos - 4) /
+                               world.trashRain.size()));
+  }
+  w.endSection();
+
+  w.beginSection(TAG_SETTLED_RAIN);
+  w.put(static_cast<uint32_t>(world.settledRain.size()));
+  recordSizePos = w.position();
+  w.put(static_cast<uint32_t>(0));
+  for (size_t i = 0; i < world.settledRain.size(); ++i) {
+    putSettled(w, world.settledRain[i]);
+  }
+  if (!world.settledRain.empty()) {
+    w.patch(recordSizePos, static_cast<uint32_t>(
+                               (w.position() - recordSizePos - 4) /
+                               world.settledRain.size()));
+  }
+  w.endSection();
+
+  w.beginSection(TAG_STRESS);
+  w.put(static_cast<int32_t>(world.stress.objectCount));
+  w.put(static_cast<int32_t>(world.stress.basketCount));
+  w.endSection();
+
+  header.sectionCount = w.sectionCount;
+  memcpy(&out[0], &header, sizeof(header));
+}
+
+// A contagem vem do arquivo: só é aceita se os registros couberem no que
+// sobrou da seção (e não forem vazios), antes de reservar qualquer coisa
+static bool validRecordList(uint32_t count, uint32_t size,
+                            const SnapshotReader &r) {
+  return count == 0 || (size > 0 && static_cast<uint64_t>(count) * size <=
+                                         r.remaining());
+}
+
+// Lista de registros: contagem, tamanho de cada registro e os registros
+template <typename T>
+static bool getRecords(SnapshotReader &r, std::vector<T> &items,
+                       void (*get)(SnapshotReader &, T &), const T &fill) {
+  uint32_t count = 0, size = 0;
+  if (!r.get(count) || !r.get(size) || !validRecordList(count, size, r)) {
+    return false;
+  }
+  items.assign(count, fill);
+  for (uint32_t i = 0; i < count; ++i) {
+    SnapshotReader record(0, 0);
+    if (!r.sub(size, record)) {
+      return false;
+    }
+    get(record, items[i]);
+  }
+  return true;
+}
+
+static bool getInt(SnapshotReader &r, int &value) {
+  int32_t v = value;
+  bool ok = r.get(v);
+  value = v;
+  return ok;
+}
+
+static bool getBool(SnapshotReader &r, bool &value) {
+  uint8_t v = value;
+  bool ok = r.get(v);
+  value = v != 0;
+  return ok;
+}
+
+static bool applySection(World &world, uint32_t tag, SnapshotReader &r) {
+  if (tag == TAG_CORE) {
+    uint32_t rng = world.rngState;
+    getInt(r, world.score);
+    getInt(r, world.misses);
+    getBool(r, world.gameOver);
+    getBool(r, world.moveLeft);
+    getBool(r, world.moveRight);
+    r.get(world.time);
+    r.get(rng);
+    world.rngState = rng != 0 ? rng : 1;
+  } else if (tag == TAG_DIFFICULTY) {
+    DifficultyParams &params = world.difficulty;
+    r.get(params.speedIncreaseRate);
+    r.get(params.scalingFactor);
+    getInt(r, params.spawnDelayInitial);
+    getInt(r, params.spawnDelayMinimum);
+    getInt(r, params.maxNumObjects);
+    r.get(world.minObjectSpeed);
+    r.get(world.maxObjectSpeedOffset);
+    getInt(r, world.scoreForNextLevel);
+    getInt(r, world.difficultyLevel);
+    getInt(r, world.spawnDelay);
+    getInt(r, world.spawnTimer);
+    r.get(world.difficultyMultiplier);
+  } else if (tag == TAG_BASKET) {
+    Basket &b = world.basket;
+    int type = b.wasteType;
+    r.get(b.x);
+    r.get(b.y);
+    r.get(b.width);
+    r.get(b.height);
+    r.get(b.speed);
+    getInt(r, type);
+    b.wasteType = static_cast<WASTE_TYPE>(type);
+  } else if (tag == TAG_OBJECTS) {
+    FallingObject fill = world.objects.empty() ? FallingObject(world)
+                                               : world.objects[0];
+    return getRecords<FallingObject>(r, world.objects, getObject, fill);
+  } else if (tag == TAG_GAME_OVER) {
+    r.get(world.gameOverAnimationTimer);
+    getInt(r, world.displayedScore);
+    getInt(r, world.finalScoreHolder);
+    r.get(world.gameOverBasketAngle);
+    r.get(world.gameOverBasketY);
+  } else if (tag == TAG_TRASH_RAIN) {
+    TrashParticle fill;
+    memset(&fill, 0, sizeof(fill));
+    return getRecords<TrashParticle>(r, world.trashRain, getParticle, fill);
+  } else if (tag == TAG_SETTLED_RAIN) {
+    SettledParticle fill;
+    memset(&fill, 0, sizeof(fill));
+    return getRecords<SettledParticle>(r, world.settledRain, getSettled,
+                                       fill);
+  } else if (tag == TAG_STRESS) {
+    getInt(r, world.stress.objectCount);
+    getInt(r, world.stress.basketCount);
+  }
+  // Tags desconhecidas (de versões mais novas) são ignoradas
+  return true;
+}
+
+bool restoreWorld(World &world, const unsigned char *data, size_t size) {
+  SnapshotReader reader(data, size);
+  WorldSnapshotHeader header;
+  if (!reader.get(header) ||
+      memcmp(header.magic, WORLD_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+    return false;
+  }
+
+  // Primeiro confere a estrutura inteira, para não deixar o World pela
+  // metade se o blob estiver truncado
+  SnapshotReader scan = reader;
+  for (uint32_t i = 0; i < header.sectionCount; ++i) {
+    uint32_t tag = 0, length = 0;
+    SnapshotReader section(0, 0);
+    if (!scan.get(tag) || !scan.get(length) || !scan.sub(length, section)) {
+      return false;
+    }
+    // Listas com contagem impossível fariam applySection falhar depois do
+    // reset(), com o World já alterado
+    uint32_t count = 0, size = 0;
+    if ((tag == TAG_OBJECTS || tag == TAG_TRASH_RAIN ||
+         tag == TAG_SETTLED_RAIN) &&
+        (!section.get(count) || !section.get(size) ||
+         !validRecordList(count, size, section))) {
+      return false;
+    }
+  }
+
+  // Campos ausentes ficam com o valor de uma partida nova
+  world.reset();
+  for (uint32_t i = 0; i < header.sectionCount; ++i) {
+    uint32_t tag = 0, length = 0;
+    SnapshotReader section(0, 0);
+    reader.get(tag);
+    reader.get(length);
+    reader.sub(length, section);
+    if (!applySection(world, tag, section)) {
+      return false;
+    }
+  }
+  // Snapshots de antes da pilha compactada guardam as partículas paradas
+  // junto com as que caem
+  world.settleStoppedParticles();
+  world.events.clear();
+  world.extraBaskets.assign(std::max(world.stress.basketCount, 0), Basket());
+  world.placeExtraBaskets();
+
+  // O jogo conta com os objetos em ordem de spawn
+  std::stable_sort(world.objects.begin(), world.objects.end(),
+                   [](const FallingObject &a, const FallingObject &b) {
+                     return a.spawnTime < b.spawnTime;
+                   });
+  return true;
+}
+
+bool saveWorldToFile(const World &world, const std::string &filepath,
+                     std::vector<unsigned char> &blob) {
+  saveWorld(world, blob);
+  return writeSnapshotFile(filepath, blob);
+}
+
+bool writeSnapshotFile(const std::string &filepath,
+                       const std::vector<unsigned char> &blob) {
+  char tmpPath[FILENAME_MAX];
+  snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", filepath.c_str());
+  FILE *file = fopen(tmpPath, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool ok = fwrite(&blob[0], 1, blob.size(), file) == blob.size();
+  ok = (fclose(file) == 0) && ok;
+  if (!ok) {
+    remove(tmpPath);
+    return false;
+  }
+#ifdef _WIN32
+  remove(filepath.c_str()); // rename() não substitui no Windows
+#endif
+  return rename(tmpPath, filepath.c_str()) == 0;
+}
+
+bool loadWorldFromFile(World &world, const std::string &filepath) {
+  FILE *file = fopen(filepath.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  std::vector<unsigned char> blob;
+  unsigned char chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    blob.insert(blob.end(), chunk, chunk + n);
+  }
+  fclose(file);
+  return !blob.empty() && restoreWorld(world, &blob[0], blob.size());
+}
@@ -0,0 +1,48 @@
+#ifndef WORLD_SNAPSHOT_H
+#define WORLD_SNAPSHOT_H
+
+#include "World.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato do snapshot de uma partida (little-endian):
+//   WorldSnapshotHeader
+//   seções { uint32 tag, uint32 tamanho, conteúdo }
+//
+// Compatibilidade entre versões: seções com tag desconhecida são puladas;
+// campos novos só são acrescentados no fim de uma seção (ou em uma seção
+// nova). Ao ler, campos além do fim da seção mantêm o valor de reset() e
+// bytes extras no fim são ignorados. Listas (objetos, partículas) gravam o
+// tamanho de cada registro, então registros também podem crescer.
+const char WORLD_SNAPSHOT_MAGIC[4] = {'C', 'S', 'W', 'S'};
+const uint32_t WORLD_SNAPSHOT_VERSION = 1;
+
+struct WorldSnapshotHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t sectionCount;
+  uint32_t reserved;
+};
+
+// Grava todo o estado da partida (objetos, cesta, pontuação, dificuldade,
+// partículas, gerador aleatório e temporizadores). Os eventos do tick não
+// entram: são consumidos antes de cada snapshot.
+void saveWorld(const World &world, std::vector<unsigned char> &out);
+
+// Restaura em um World existente; false se o blob não for um snapshot
+// válido (o World fica como estava)
+bool restoreWorld(World &world, const unsigned char *data, size_t size);
+
+// Escrita atômica (arquivo temporário + rename), segura contra queda no
+// meio. blob é o buffer da serialização, reaproveitado entre gravações.
+bool saveWorldToFile(const World &world, const std::string &filepath,
+                     std::vector<unsigned char> &blob);
+// Mesma escrita para um blob já serializado por saveWorld (o autosave
+// serializa na simulação e grava em outra thread)
+bool writeSnapshotFile(const std::string &filepath,
+                       const std::vector<unsigned char> &blob);
+bool loadWorldFromFile(World &world, const std::string &filepath);
+
+#endif // WORLD_SNAPSHOT_H
@@ -1,52 +1,106 @@
 #include <GL/glut.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 // Incluir os módulos organizados
+#include "AllocStats.h"
 #include "AudioManager.h"
 #include "GameConstants.h"
 #include "GameLoop.h"
 #include "GameState.h"
+#include "GlStats.h"
 #include "InputHandler.h"
+#include "MemoryStats.h"
 #include "RankingSystem.h"
 #include "Scenery.h"
+#include "SceneryShader.h"
+#include "SimulationThread.h"
+
+// Verifica se uma opção foi passada na linha de comando
+static bool hasArgument(int argc, char **argv, const char *option) {
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], option) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Valor inteiro de uma opção ("--stress 2000"), ou fallback se ausente
+static int argumentValue(int argc, char **argv, const char *option,
+                         int fallback) {
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], option) == 0) {
+      return atoi(argv[i + 1]);
+    }
+  }
+  return fallback;
+}
+
+// Texto de uma opção ("--gl-stats gl.csv"), ou NULL se ausente
+static const char *argumentString(int argc, char **argv, const char *option) {
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], option) == 0) {
+      return argv[i + 1];
+    }
+  }
+  return NULL;
+}
+
+static void printAudioReportAtExit() { audioManager.printLatencyReport(); }
+
+// Mede a latência dos efeitos sem abrir janela. Funciona sem placa de som
+// usando SDL_AUDIODRIVER=dummy ou SDL_AUDIODRIVER=disk.
+static int runAudioProbe() {
+  if (!audioManager.initialize()) {
+    printf("Erro: sistema de áudio não pôde ser inicializado.\n");
+    return 1;
+  }
+  audioManager.openAssetPack(AUDIO_PACK);
+  if (!audioManager.loadSound("collect_correct", SOUND_COLLECT_CORRECT)) {
+    return 1;
+  }
+
+  const int triggers = 200, intervalMs = 50;
+  for (int i = 0; i < triggers; ++i) {
+    audioManager.playSound("collect_correct");
+    audioManager.flushSounds();
+    SDL_Delay(intervalMs);
+    audioManager.monitorLatency();
+  }
+  audioManager.printLatencyReport();
+  audioManager.cleanup();
+  return 0;
+}
 
 // Função Principal
 int main(int argc, char **argv) {
     // Inicializa o gerador de números aleatórios
     srand(static_cast<unsigned int>(time(0)));
+    world.seed(static_cast<unsigned int>(time(0)));
 
-    // Carrega o ranking do arquivo ao iniciar o jogo
-    loadRanking(ranking);
-
-    // Inicializar sistema de áudio
-    if (audioManager.initialize()) {
-      printf("Sistema de áudio inicializado com sucesso!\n");
-
-      // Carregar arquivos de música (opcional - se não existirem, o jogo
-      // continua sem áudio)
-      audioManager.loadMusic("menu", MUSIC_MENU);
-      audioManager.loadMusic("gameplay", MUSIC_GAMEPLAY);
-      audioManager.loadMusic("gameover", MUSIC_GAMEOVER);
+    // Modo stress: milhares de objetos e várias cestas automáticas
+    world.stress.objectCount =
+        std::max(0, argumentValue(argc, argv, "--stress", 0));
+    world.stress.basketCount = std::max(
+        0, argumentValue(argc, argv, "--baskets", world.isStress() ? 4 : 0));
 
-      // Carregar efeitos sonoros
-      audioManager.loadSound("collect_correct", SOUND_COLLECT_CORRECT);
-      audioManager.loadSound("collect_wrong", SOUND_COLLECT_WRONG);
-      audioManager.loadSound("button_click", SOUND_BUTTON_CLICK);
+    // Marca o início para medir o tempo até o primeiro frame
+    markStartupTime();
 
-      // Configurar volumes
-      audioManager.setMusicVolume(16); // Volume mais baixo para música de fundo
-      audioManager.setSoundVolume(96); // Volume médio para efeitos
-
-      // Iniciar música do menu
-      audioManager.playMusic("menu");
-    } else {
-      printf("Aviso: Sistema de áudio não pôde ser inicializado. O jogo "
-             "continuará sem som.\n");
+    // Buffer de áudio pequeno (cai para buffers maiores se houver underruns)
+    audioManager.setLowLatencyMode(hasArgument(argc, argv, "--low-latency"));
+    if (hasArgument(argc, argv, "--audio-probe")) {
+      return runAudioProbe();
     }
 
-    // Configurações iniciais do GLUT
+    // Carrega o ranking do arquivo ao iniciar o jogo
+    loadRanking(ranking);
+
+    // Configurações iniciais do GLUT (a janela aparece antes do áudio)
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_ALPHA | GLUT_MULTISAMPLE);
     glutInitWindowSize(windowWidth, windowHeight);
@@ -60,20 +114,114 @@ int main(int argc, char **argv) {
     glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
 
     // Inicializações dos componentes do jogo
-    updateWindowTitle();
     initUrbanScenery(cityscape);
+    // Céu, chão e janelas em GLSL; sem suporte, segue o desenho pela CPU
+    if (hasArgument(argc, argv, "--shaders")) {
+      initSceneryShader();
+    }
     initPauseMenu();
     initHomeScreen();
 
+    // Inicializar sistema de áudio
+    if (audioManager.initialize()) {
+      printf("Sistema de áudio inicializado com sucesso!\n");
+      if (hasArgument(argc, argv, "--audio-report")) {
+        atexit(printAudioReportAtExit);
+      }
+
+      // Usa o pacote gerado pelo build; sem ele, lê os arquivos soltos
+      if (!audioManager.openAssetPack(AUDIO_PACK)) {
+        printf("Aviso: %s nao encontrado, usando arquivos de %s\n",
+               AUDIO_PACK.c_str(), AUDIO_DIR.c_str());
+      }
+
+      // Músicas curtas são decodificadas uma única vez para um cache em
+      // disco e mapeadas nas execuções seguintes (desativável com
+      // --no-pcm-cache)
+      if (!hasArgument(argc, argv, "--no-pcm-cache")) {
+        audioManager.enablePcmCache(PCM_CACHE_DIR);
+      }
+
+      // Arquivos de música e efeitos são decodificados em segundo plano e
+      // ficam disponíveis à medida que terminam (se não existirem, o jogo
+      // continua sem áudio)
+      audioManager.queueMusic("menu", MUSIC_MENU);
+      audioManager.queueMusic("gameover", MUSIC_GAMEOVER);
+
+      // Prioridade e limite de cópias simultâneas de cada efeito: cliques
+      // da interface nunca são cortados por uma rajada de coletas
+      audioManager.configureSound("button_click", 3, 2);
+      audioManager.configureSound("collect_wrong", 2, 3);
+      audioManager.configureSound("collect_correct", 1, 3);
+
+      audioManager.queueSound("collect_correct", SOUND_COLLECT_CORRECT);
+      audioManager.queueSound("collect_wrong", SOUND_COLLECT_WRONG);
+      audioManager.queueSound("button_click", SOUND_BUTTON_CLICK);
+
+      audioManager.startAsyncLoading();
+
+      // Configurar volumes
+      audioManager.setMusicVolume(16); // Volume mais baixo para música de fundo
+      audioManager.setSoundVolume(96); // Volume médio para efeitos
+
+      // Iniciar música do menu (começa assim que terminar de carregar)
+      audioManager.playMusic("menu");
+    } else {
+      printf("Aviso: Sistema de áudio não pôde ser inicializado. O jogo "
+             "continuará sem som.\n");
+    }
+
     // Registra as funções de callback do GLUT
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
     glutKeyboardFunc(keyboard);
+    glutKeyboardUpFunc(keyboardUp);
     glutSpecialFunc(specialKeyboard);
     glutSpecialUpFunc(specialKeyboardUp);
     glutMouseFunc(mouseClick);
     glutPassiveMotionFunc(mousePassiveMotion);
-    glutTimerFunc(0, update, 0);
+    glutTimerFunc(0, renderTimer, 0);
+
+    // Retoma a partida salva automaticamente (depois de uma queda ou de
+    // um reinício do quiosque), começando pausada
+    if (hasArgument(argc, argv, "--resume") && !resumeSavedGame()) {
+      printf("Nenhuma partida salva em %s\n", SAVEGAME_FILENAME.c_str());
+    }
+
+    // Qualidade visual automática, ou fixa com --quality 0..3
+    setFixedQuality(argumentValue(argc, argv, "--quality", -1));
+
+    // Contadores de GL por tela (build com make GLSTATS=1), no stdout e
+    // opcionalmente em CSV ao sair
+    const char *glStatsFile = argumentString(argc, argv, "--gl-stats");
+    if (glStatsFile) {
+      glStatsSetExportFile(glStatsFile);
+    }
+    if (glStatsEnabled() || glStatsFile) {
+      atexit(glStatsReport);
+    }
+
+    // Alocações em frames estáveis (build com make ALLOCSTATS=1); com
+    // --alloc-trap a primeira delas aborta, para ver a pilha no depurador
+    if (allocStatsEnabled()) {
+      allocStatsSetTrap(hasArgument(argc, argv, "--alloc-trap"));
+      atexit(allocStatsReport);
+    }
+
+    // Memória de cada subsistema (vivo e pico) no stdout ao sair
+    atexit(memoryStatsReport);
+
+    // Grava a sessão desde o primeiro frame (suporte em quiosques)
+    const char *recordFile = argumentString(argc, argv, "--record");
+    if (recordFile) {
+      startRecording(recordFile);
+    }
+
+    // Jogador automático (demonstração e testes manuais)
+    setAutoplay(hasArgument(argc, argv, "--autoplay"));
+
+    // A partir daqui o estado do jogo pertence à thread de simulação
+    startSimulationThread();
 
     // Entra no loop principal de eventos do GLUT
     glutMainLoop();